@@ -4,6 +4,41 @@
 #include <iostream>
 #include <algorithm> // Required for std::transform
 #include <vector> // Required for std::vector
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Parses a rate such as "2.5G", "800M", "64K" or "1000000" into bits per second.
+ * Suffixes are decimal (K = 1000), as in iperf.
+ */
+long long parseBitrate(const std::string& text) {
+    size_t consumed = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &consumed);
+    } catch (const std::exception&) {
+        throw std::runtime_error("Invalid value for --bitrate: " + text);
+    }
+    double scale = 1.0;
+    const std::string suffix = text.substr(consumed);
+    if (suffix == "k" || suffix == "K") {
+        scale = 1e3;
+    } else if (suffix == "m" || suffix == "M") {
+        scale = 1e6;
+    } else if (suffix == "g" || suffix == "G") {
+        scale = 1e9;
+    } else if (!suffix.empty()) {
+        throw std::runtime_error("Invalid value for --bitrate: " + text + " (use a K, M or G suffix).");
+    }
+    if (!std::isfinite(value) || value < 0.0) {
+        throw std::runtime_error("Invalid value for --bitrate: " + text);
+    }
+    return std::llround(value * scale);
+}
+
+} // namespace
 
 /**
  * @brief Constructs the CLIHandler.
@@ -112,6 +147,10 @@ CLIHandler::ParsedCommandLine CLIHandler::parseArgs(int argc, char* argv[]) {
             config.setPacketSize(std::stoi(argv[++i]));
         } else if (arg == "--num-packets" && i + 1 < argc) {
             config.setNumPackets(std::stoi(argv[++i]));
+        } else if ((arg == "--time" || arg == "-t") && i + 1 < argc) {
+            config.setTestDuration(std::stod(argv[++i]));
+        } else if ((arg == "--omit" || arg == "-O") && i + 1 < argc) {
+            config.setOmitSeconds(std::stod(argv[++i]));
         } else if (arg == "--interval-ms" && i + 1 < argc) {
             config.setSendIntervalMs(std::stoi(argv[++i]));
         } else if (arg == "--save-logs" && i + 1 < argc) {
@@ -123,8 +162,48 @@ CLIHandler::ParsedCommandLine CLIHandler::parseArgs(int argc, char* argv[]) {
             } else {
                 throw std::runtime_error("Invalid value for --save-logs. Must be 'true' or 'false'.");
             }
+        } else if (arg == "--log-flush-ms" && i + 1 < argc) {
+            config.setLogFlushMs(std::stoi(argv[++i]));
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            config.setLogLevel(argv[++i]);
+        } else if (arg == "--log-format" && i + 1 < argc) {
+            config.setLogFormat(argv[++i]);
         } else if (arg == "--handshake-timeout-ms" && i + 1 < argc) {
             config.setHandshakeTimeoutMs(std::stoi(argv[++i]));
+        } else if (arg == "--backend" && i + 1 < argc) {
+            config.setNetworkBackend(argv[++i]);
+        } else if ((arg == "--parallel" || arg == "-P") && i + 1 < argc) {
+            config.setParallelStreams(std::stoi(argv[++i]));
+        } else if (arg == "--zerocopy" && i + 1 < argc) {
+            std::string val = argv[++i];
+            if (val == "true") {
+                config.setZeroCopy(true);
+            } else if (val == "false") {
+                config.setZeroCopy(false);
+            } else {
+                throw std::runtime_error("Invalid value for --zerocopy. Must be 'true' or 'false'.");
+            }
+        } else if (arg == "--batch" && i + 1 < argc) {
+            config.setSendBatchSize(std::stoi(argv[++i]));
+        } else if (arg == "--integrity" && i + 1 < argc) {
+            config.setIntegrity(argv[++i]);
+        } else if (arg == "--verify" && i + 1 < argc) {
+            config.setVerification(argv[++i]);
+        } else if (arg == "--verify-sample" && i + 1 < argc) {
+            config.setVerificationSampleInterval(std::stoi(argv[++i]));
+        } else if ((arg == "--bitrate" || arg == "-b") && i + 1 < argc) {
+            config.setBitrate(parseBitrate(argv[++i]));
+        } else if (arg == "--busy-wait" && i + 1 < argc) {
+            std::string val = argv[++i];
+            if (val == "true") {
+                config.setPacingBusyWait(true);
+            } else if (val == "false") {
+                config.setPacingBusyWait(false);
+            } else {
+                throw std::runtime_error("Invalid value for --busy-wait. Must be 'true' or 'false'.");
+            }
+        } else if (arg == "--pacing" && i + 1 < argc) {
+            config.setPacing(argv[++i]);
         } else if (arg == "--run-id" && i + 1 < argc) {
             runOptions.runId = argv[++i];
         } else if (arg == "--result-dir" && i + 1 < argc) {
@@ -143,7 +222,7 @@ CLIHandler::ParsedCommandLine CLIHandler::parseArgs(int argc, char* argv[]) {
                 throw std::runtime_error("Invalid value for --quiet. Must be 'true' or 'false'.");
             }
         } else if (arg.rfind("--", 0) == 0) {
-            const std::vector<std::string> known_args = {"--mode", "--config", "--target", "--port", "--packet-size", "--num-packets", "--interval-ms", "--save-logs", "--handshake-timeout-ms", "--run-id", "--result-dir", "--result-json", "--result-pipe", "--quiet", "--help", "-h", "--version", "-v"};
+            const std::vector<std::string> known_args = {"--mode", "--config", "--target", "--port", "--packet-size", "--num-packets", "--time", "--omit", "--interval-ms", "--save-logs", "--log-flush-ms", "--log-level", "--log-format", "--handshake-timeout-ms", "--backend", "--parallel", "--zerocopy", "--batch", "--integrity", "--verify", "--verify-sample", "--bitrate", "--busy-wait", "--pacing", "--run-id", "--result-dir", "--result-json", "--result-pipe", "--quiet", "--help", "-h", "--version", "-v"};
             bool is_known = false;
             for(const auto& known : known_args) {
                 if (arg == known) {
@@ -190,10 +269,30 @@ void CLIHandler::printHelp() {
               << "  --target <ip_address>     Target IP address for the client (e.g., 192.168.1.100).\n"
               << "  --port <port_number>      Port number for the connection (e.g., 5201).\n"
               << "  --packet-size <bytes>     Size of data packets in bytes (includes header).\n"
-              << "  --num-packets <count>     Number of packets to send (0 for unlimited until interrupted).\n"
+              << "  --num-packets <count>     Number of packets to send per stream (0 for unlimited until interrupted).\n"
+              << "  -t, --time <seconds>      Send for this long in each phase, then finish (default 0 = no time limit).\n"
+              << "                            With --num-packets too, whichever limit is reached first ends the phase.\n"
+              << "  -O, --omit <seconds>      Send but leave the first seconds of each phase out of the statistics\n"
+              << "                            (TCP slow start, cold caches). --time counts after this window.\n"
+              << "  -P, --parallel <count>    Number of parallel TCP data streams (default 1). Stream i uses port + i.\n"
               << "  --interval-ms <ms>        Delay between sending packets in milliseconds (0 for continuous send).\n"
               << "  --save-logs <true|false>  Save console logs to a file in the 'Log' directory.\n"
+              << "  --log-flush-ms <ms>       Longest time log lines are held before being written (default 100, 0 = at once).\n"
+              << "  --log-level <level>       Least severe messages logged: error, warning, info or debug (default info).\n"
+              << "  --log-format <text|binary>  Format of --save-logs files (default text). Binary segments are\n"
+              << "                            read back with LogDecoder.\n"
               << "  --handshake-timeout-ms <ms>  Timeout to wait for CONFIG_ACK before aborting (default 5000).\n"
+              << "  --backend <default|epoll|io_uring>  Local async network backend (default: epoll on Linux, IOCP on Windows).\n"
+              << "  --zerocopy <true|false>   Send data packets with MSG_ZEROCOPY (Linux epoll backend; worthwhile for packets >= 16KB).\n"
+              << "  --batch <packets>         Packets assembled into one send call (1-1024, default 1).\n"
+              << "  --integrity <algorithm>   Data packet checksum: sum, crc32c or xxh3 (default sum). Negotiated with the server.\n"
+              << "  --verify <policy>         Received payload checks: full, header-only or sampled (default full).\n"
+              << "  --verify-sample <N>       With --verify sampled, check every Nth packet (default 64).\n"
+              << "  -b, --bitrate <rate>      Pace each stream to this rate in bits/s, e.g. 2.5G, 800M, 64K (default 0 = unlimited).\n"
+              << "                            Takes precedence over --interval-ms.\n"
+              << "  --busy-wait <true|false>  With --bitrate, spin instead of sleeping for send gaps under 10us.\n"
+              << "  --pacing <user|kernel>    With --bitrate, pace in the sender (user) or cap the socket with\n"
+              << "                            SO_MAX_PACING_RATE (kernel, Linux backends). Default user.\n"
               << "  --run-id <id>             Set a stable ID for this test run.\n"
               << "  --result-dir <path>       Directory for result-<runId>-<ROLE>.json files (default Results).\n"
               << "  --result-json <path>      Also write this run result to the exact JSON path.\n"
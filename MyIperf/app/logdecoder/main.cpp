@@ -0,0 +1,164 @@
+// Renders binary log segments written with --log-format binary back into the
+// text log format, "[YYYY-mm-dd HH:MM:SS] Info: ...", one line per record.
+//
+// Usage: LogDecoder [--level <error|warning|info|debug>]
+//                   [--from "YYYY-mm-dd HH:MM:SS"] [--to "YYYY-mm-dd HH:MM:SS"]
+//                   <segment.binlog>...
+//
+// Segments are decoded in the order given; Log/ipeftc_CLIENT_<time>_<pid>_*.binlog
+// expands to one run in order. --level keeps records of that level and more
+// severe ones, as --log-level does. --from and --to are local times and
+// include the whole second they name.
+
+#include "BinaryLog.h"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**< Decoded text is written out in chunks of about this size. */
+constexpr size_t kOutputChunkBytes = 1024 * 1024;
+
+struct Options {
+    LogLevel maxLevel = LogLevel::Debug;
+    std::time_t from = 0;
+    std::time_t to = 0;
+    bool hasFrom = false;
+    bool hasTo = false;
+    std::vector<std::string> files;
+};
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+                 "Usage: %s [--level <error|warning|info|debug>] [--from \"YYYY-mm-dd HH:MM:SS\"]\n"
+                 "       [--to \"YYYY-mm-dd HH:MM:SS\"] <segment.binlog>...\n",
+                 program);
+}
+
+bool parseLevel(const std::string& name, LogLevel& level) {
+    if (name == "error") level = LogLevel::Error;
+    else if (name == "warning") level = LogLevel::Warning;
+    else if (name == "info") level = LogLevel::Info;
+    else if (name == "debug") level = LogLevel::Debug;
+    else return false;
+    return true;
+}
+
+bool parseLocalTime(const std::string& text, std::time_t& result) {
+    std::tm local_tm{};
+    std::istringstream input(text);
+    input >> std::get_time(&local_tm, "%Y-%m-%d %H:%M:%S");
+    if (input.fail()) {
+        return false;
+    }
+    local_tm.tm_isdst = -1;
+    result = std::mktime(&local_tm);
+    return result != static_cast<std::time_t>(-1);
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--level" && i + 1 < argc) {
+            if (!parseLevel(argv[++i], options.maxLevel)) {
+                std::fprintf(stderr, "Unknown level '%s'.\n", argv[i]);
+                return false;
+            }
+        } else if (arg == "--from" && i + 1 < argc) {
+            if (!parseLocalTime(argv[++i], options.from)) {
+                std::fprintf(stderr, "Invalid --from time '%s'.\n", argv[i]);
+                return false;
+            }
+            options.hasFrom = true;
+        } else if (arg == "--to" && i + 1 < argc) {
+            if (!parseLocalTime(argv[++i], options.to)) {
+                std::fprintf(stderr, "Invalid --to time '%s'.\n", argv[i]);
+                return false;
+            }
+            options.hasTo = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            std::fprintf(stderr, "Unknown option '%s'.\n", arg.c_str());
+            return false;
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    return !options.files.empty();
+}
+
+/**
+ * @brief Builds the "[YYYY-mm-dd HH:MM:SS] " prefix of the text log, once per second.
+ */
+class TimestampFormatter {
+public:
+    const std::string& prefix(std::time_t seconds) {
+        if (seconds != cachedSecond) {
+            cachedSecond = seconds;
+            std::tm local_tm = *std::localtime(&seconds);
+            std::ostringstream oss;
+            oss << "[" << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S") << "] ";
+            cachedPrefix = oss.str();
+        }
+        return cachedPrefix;
+    }
+
+private:
+    std::time_t cachedSecond = -1;
+    std::string cachedPrefix;
+};
+
+std::time_t secondsOf(int64_t wallNs) {
+    const std::chrono::system_clock::time_point wall(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(wallNs)));
+    return std::chrono::system_clock::to_time_t(wall);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    TimestampFormatter timestamps;
+    BinaryLogReader reader;
+    BinaryLogReader::Record record;
+    std::string output;
+    int status = 0;
+
+    for (const std::string& file : options.files) {
+        std::string error;
+        if (!reader.open(file, error)) {
+            std::fprintf(stderr, "%s\n", error.c_str());
+            status = 1;
+            continue;
+        }
+        while (reader.next(record)) {
+            if (record.level > options.maxLevel) {
+                continue;
+            }
+            const std::time_t seconds = secondsOf(record.wallNs);
+            if ((options.hasFrom && seconds < options.from) || (options.hasTo && seconds > options.to)) {
+                continue;
+            }
+            output += timestamps.prefix(seconds);
+            output += record.text;
+            output += '\n';
+            if (output.size() >= kOutputChunkBytes) {
+                std::fwrite(output.data(), 1, output.size(), stdout);
+                output.clear();
+            }
+        }
+    }
+    std::fwrite(output.data(), 1, output.size(), stdout);
+    std::fflush(stdout);
+    return status;
+}
@@ -0,0 +1,204 @@
+// Compares the calculateChecksum() kernels against the scalar reference, the
+// receive-side payload content checks, and the data packet integrity
+// algorithms against each other.
+//
+// First checks that every sum kernel the CPU supports returns the scalar
+// result, and the selected CRC-32C kernel the table result, for all sizes up
+// to a few hundred bytes and every start alignment, and that PayloadVerifier
+// agrees with buildExpectedPayload(). Then times each over typical packet sizes.
+//
+// Usage: ChecksumBenchmark [megabytes per measurement, default 512]
+
+#include "Checksum.h"
+#include "PayloadVerifier.h"
+#include "myiperf/Protocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+bool verifyKernels(const std::vector<Checksum::Kernel>& kernels, const std::vector<char>& data) {
+    bool ok = true;
+    for (size_t offset = 0; offset < 64; ++offset) {
+        for (size_t size = 0; size <= 600; ++size) {
+            const uint32_t expected = Checksum::sumScalar(data.data() + offset, size);
+            for (const auto& kernel : kernels) {
+                const uint32_t actual = kernel.function(data.data() + offset, size);
+                if (actual != expected) {
+                    std::printf("MISMATCH: %s offset=%zu size=%zu expected=%u actual=%u\n",
+                                kernel.name, offset, size, expected, actual);
+                    ok = false;
+                }
+            }
+        }
+    }
+    // Large buffers of 0xFF exercise the wrap-around of the 32-bit sum.
+    const std::vector<char> ones(static_cast<size_t>(17) * 1024 * 1024 + 13, static_cast<char>(0xFF));
+    const uint32_t expected = Checksum::sumScalar(ones.data(), ones.size());
+    for (const auto& kernel : kernels) {
+        if (kernel.function(ones.data(), ones.size()) != expected) {
+            std::printf("MISMATCH: %s on %zu bytes of 0xFF\n", kernel.name, ones.size());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+bool verifyIntegrityKernels(const std::vector<char>& data) {
+    bool ok = true;
+    // Standard CRC-32C check value.
+    if (Checksum::crc32cSoftware("123456789", 9) != 0xE3069283u) {
+        std::printf("MISMATCH: crc32c table check value\n");
+        ok = false;
+    }
+    const Checksum::Kernel& crc32c = Checksum::selectedCrc32cKernel();
+    for (size_t offset = 0; offset < 64; ++offset) {
+        for (size_t size = 0; size <= 600; ++size) {
+            const uint32_t expected = Checksum::crc32cSoftware(data.data() + offset, size);
+            const uint32_t actual = crc32c.function(data.data() + offset, size);
+            if (actual != expected) {
+                std::printf("MISMATCH: crc32c %s offset=%zu size=%zu expected=%08x actual=%08x\n",
+                            crc32c.name, offset, size, expected, actual);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+bool verifyPayloadVerifier() {
+    bool ok = true;
+    for (uint32_t counter : {0u, 7u, 99999u, 4294967295u}) {
+        for (size_t size = 0; size <= 300; ++size) {
+            std::string payload = buildExpectedPayload(counter, size);
+            if (!PayloadVerifier::matchesExpected(counter, payload)) {
+                std::printf("MISMATCH: verifier rejected counter=%u size=%zu\n", counter, size);
+                ok = false;
+            }
+            for (size_t i = 0; i < size; ++i) {
+                payload[i] ^= 0x01;
+                if (PayloadVerifier::matchesExpected(counter, payload)) {
+                    std::printf("MISMATCH: verifier missed corruption counter=%u size=%zu at=%zu\n", counter, size, i);
+                    ok = false;
+                }
+                payload[i] ^= 0x01;
+            }
+        }
+    }
+    return ok;
+}
+
+double measureNanosPerCall(Checksum::KernelFunction function, const char* data, size_t size,
+                           size_t iterations, uint32_t& sink) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        sink += function(data, size);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
+
+void printTable(const std::vector<Checksum::Kernel>& kernels, const std::vector<char>& data,
+                double megabytes, uint32_t& sink) {
+    const size_t sizes[] = {64, 256, 1024, 1500, 4096, 8192, 16384, 65536};
+    std::printf("%8s  %-10s %12s %10s %9s\n", "size", "kernel", "ns/call", "GB/s", "speedup");
+    for (const size_t size : sizes) {
+        const size_t iterations =
+            std::max<size_t>(1, static_cast<size_t>(megabytes * 1024 * 1024 / static_cast<double>(size)));
+        double baselineNanos = 0.0;
+        for (const auto& kernel : kernels) {
+            // Warm up, then measure.
+            measureNanosPerCall(kernel.function, data.data(), size, iterations / 10 + 1, sink);
+            const double nanos = measureNanosPerCall(kernel.function, data.data(), size, iterations, sink);
+            if (baselineNanos == 0.0) {
+                baselineNanos = nanos;
+            }
+            std::printf("%8zu  %-10s %12.1f %10.2f %8.2fx\n", size, kernel.name, nanos,
+                        static_cast<double>(size) / nanos, baselineNanos / nanos);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double megabytes = argc > 1 ? std::atof(argv[1]) : 512.0;
+    if (megabytes <= 0.0) {
+        std::printf("Usage: %s [megabytes per measurement]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<char> data(static_cast<size_t>(1) << 20);
+    std::mt19937 rng(12345);
+    for (auto& byte : data) {
+        byte = static_cast<char>(rng() & 0xFF);
+    }
+
+    const auto kernels = Checksum::supportedKernels();
+    std::printf("Kernels:");
+    for (const auto& kernel : kernels) {
+        std::printf(" %s", kernel.name);
+    }
+    std::printf(" (calculateChecksum uses %s)\n", Checksum::selectedKernel().name);
+
+    if (!verifyKernels(kernels, data)) {
+        std::printf("FAILED: kernels disagree with the scalar checksum\n");
+        return 1;
+    }
+    std::printf("All kernels match the scalar checksum.\n\n");
+
+    if (!verifyIntegrityKernels(data)) {
+        std::printf("FAILED: CRC-32C kernel disagrees with the table implementation\n");
+        return 1;
+    }
+    std::printf("CRC-32C %s kernel matches the table implementation.\n\n",
+                Checksum::selectedCrc32cKernel().name);
+
+    if (!verifyPayloadVerifier()) {
+        std::printf("FAILED: PayloadVerifier disagrees with buildExpectedPayload\n");
+        return 1;
+    }
+    std::printf("PayloadVerifier matches buildExpectedPayload and detects every single-byte change.\n\n");
+
+    uint32_t sink = 0;
+    std::printf("Sum kernels:\n");
+    printTable(kernels, data, megabytes, sink);
+
+    // Under the sum the receiver also checks the payload content, which the strong
+    // algorithms make unnecessary. "sum+cmp" is that cost with a rebuilt expected
+    // payload, "sum+verify" with PayloadVerifier.
+    const Checksum::KernelFunction sumAndCompare = [](const char* payload, size_t size) -> uint32_t {
+        const std::string expected = buildExpectedPayload(7, size);
+        return calculateChecksum(payload, size) + (std::memcmp(payload, expected.data(), size) == 0);
+    };
+    const Checksum::KernelFunction sumAndVerify = [](const char* payload, size_t size) -> uint32_t {
+        return calculateChecksum(payload, size) +
+               PayloadVerifier::matchesExpected(7, std::span<const char>(payload, size));
+    };
+    const std::vector<char> expectedPayload = [] {
+        const std::string text = buildExpectedPayload(7, 65536);
+        return std::vector<char>(text.begin(), text.end());
+    }();
+    std::printf("\nPayload content checks:\n");
+    printTable({{"sum+cmp", sumAndCompare}, {"sum+verify", sumAndVerify}}, expectedPayload, megabytes, sink);
+
+    const std::vector<Checksum::Kernel> integrity{
+        {"sum", &calculateChecksum},
+        {"crc32c-tbl", &Checksum::crc32cSoftware},
+        {"crc32c", Checksum::selectedCrc32cKernel().function},
+        {"xxh3", &Checksum::xxh3Low32},
+    };
+    std::printf("\nIntegrity algorithms (speedup relative to sum):\n");
+    printTable(integrity, data, megabytes, sink);
+
+    std::printf("\n(checksum sink: %u)\n", sink);
+    return 0;
+}
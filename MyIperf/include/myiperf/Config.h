@@ -52,6 +52,31 @@ public:
      */
     int getNumPackets() const;
 
+    /**
+     * @brief Limits each data phase to a wall-clock duration.
+     * @param seconds Sending time per phase; 0 means no time limit. With
+     *        numPackets also set, whichever limit is reached first ends the phase.
+     */
+    void setTestDuration(double seconds);
+    /**
+     * @brief Gets the time limit of each data phase.
+     * @return Seconds, or 0 if phases are not time limited.
+     */
+    double getTestDuration() const;
+
+    /**
+     * @brief Sets a warm-up window at the start of each data phase that is
+     *        excluded from the measured statistics.
+     * @param seconds Window length; 0 disables it. A --time limit counts
+     *        after the window.
+     */
+    void setOmitSeconds(double seconds);
+    /**
+     * @brief Gets the warm-up window length.
+     * @return Seconds, or 0 if nothing is omitted.
+     */
+    double getOmitSeconds() const;
+
     /**
      * @brief Sets the interval between sending packets.
      * @param intervalMs The interval in milliseconds. 0 means no delay.
@@ -118,6 +143,41 @@ public:
      */
     bool getSaveLogs() const;
 
+    /**
+     * @brief Sets how long the logger may hold formatted lines before writing them.
+     * @param intervalMs Milliseconds (0-60000). 0 writes every drained batch at once.
+     */
+    void setLogFlushMs(int intervalMs);
+    /**
+     * @brief Gets the logger flush interval.
+     * @return Milliseconds.
+     */
+    int getLogFlushMs() const;
+
+    /**
+     * @brief Sets the least severe messages that are logged.
+     * @param level "error", "warning", "info" or "debug". Debug messages also
+     *        need a build with MYIPERF_ENABLE_DEBUG_LOGS.
+     */
+    void setLogLevel(const std::string& level);
+    /**
+     * @brief Gets the log level.
+     * @return "error", "warning", "info" or "debug".
+     */
+    std::string getLogLevel() const;
+
+    /**
+     * @brief Sets the format of the log files written with --save-logs.
+     * @param format "text" for .log files, or "binary" for .binlog segments
+     *        that LogDecoder turns back into text.
+     */
+    void setLogFormat(const std::string& format);
+    /**
+     * @brief Gets the log file format.
+     * @return "text" or "binary".
+     */
+    std::string getLogFormat() const;
+
     /**
      * @brief Serializes the Config object to a JSON object.
      * @return A nlohmann::json object representing the configuration.
@@ -143,11 +203,139 @@ public:
      */
     int getHandshakeTimeoutMs() const;
 
+    /**
+     * @brief Sets the asynchronous network backend used by this process.
+     * @param backend "default", "epoll" or "io_uring". "default" selects the
+     *        platform backend (epoll on Linux, IOCP on Windows).
+     */
+    void setNetworkBackend(const std::string& backend);
+
+    /**
+     * @brief Gets the asynchronous network backend used by this process.
+     * @return The backend name.
+     */
+    std::string getNetworkBackend() const;
+
+    /**
+     * @brief Sets the number of parallel TCP data streams.
+     * @param streams Number of data connections (1 to 128). Stream i uses port + i.
+     */
+    void setParallelStreams(int streams);
+
+    /**
+     * @brief Gets the number of parallel TCP data streams.
+     * @return The number of data connections.
+     */
+    int getParallelStreams() const;
+
+    /**
+     * @brief Sets whether data packets are sent with MSG_ZEROCOPY.
+     * @param enabled True to avoid the kernel copy for large sends (Linux epoll backend).
+     */
+    void setZeroCopy(bool enabled);
+
+    /**
+     * @brief Gets whether data packets are sent with MSG_ZEROCOPY.
+     * @return True if zero-copy sends are requested.
+     */
+    bool getZeroCopy() const;
+
+    /**
+     * @brief Sets how many data packets are assembled into a single send.
+     * @param packets Packets per send call (1 to 1024). 1 sends each packet on its own.
+     */
+    void setSendBatchSize(int packets);
+
+    /**
+     * @brief Gets how many data packets are assembled into a single send.
+     * @return Packets per send call.
+     */
+    int getSendBatchSize() const;
+
+    /**
+     * @brief Sets the data packet integrity algorithm the client proposes.
+     * @param algorithm "sum", "crc32c" or "xxh3". On the client this is replaced
+     *        by the algorithm the server confirms in CONFIG_ACK.
+     */
+    void setIntegrity(const std::string& algorithm);
+
+    /**
+     * @brief Gets the data packet integrity algorithm.
+     * @return The algorithm name.
+     */
+    std::string getIntegrity() const;
+
+    /**
+     * @brief Sets how much of each received data packet payload is checked.
+     * @param policy "full", "header-only" or "sampled". Applies to both receivers.
+     */
+    void setVerification(const std::string& policy);
+
+    /**
+     * @brief Gets the payload verification policy.
+     * @return The policy name.
+     */
+    std::string getVerification() const;
+
+    /**
+     * @brief Sets N for the "sampled" policy: every Nth packet is fully checked.
+     * @param interval 1 to 1000000.
+     */
+    void setVerificationSampleInterval(int interval);
+
+    /**
+     * @brief Gets N for the "sampled" policy.
+     * @return The sample interval.
+     */
+    int getVerificationSampleInterval() const;
+
+    /**
+     * @brief Sets the send rate each generator paces its data stream to.
+     * @param bitsPerSecond Target rate per stream; 0 sends as fast as possible.
+     */
+    void setBitrate(long long bitsPerSecond);
+
+    /**
+     * @brief Gets the paced send rate per stream.
+     * @return Bits per second, or 0 if sending is not rate limited.
+     */
+    long long getBitrate() const;
+
+    /**
+     * @brief Lets the pacer spin instead of sleeping for very short send gaps.
+     * @param enabled True to busy-wait gaps below 10 microseconds.
+     */
+    void setPacingBusyWait(bool enabled);
+
+    /**
+     * @brief Gets whether the pacer busy-waits short send gaps.
+     * @return True if busy-waiting is enabled.
+     */
+    bool getPacingBusyWait() const;
+
+    /**
+     * @brief Selects what enforces --bitrate.
+     * @param mechanism "user" for the generator's token bucket, or "kernel" for a
+     *        SO_MAX_PACING_RATE cap on the data socket. Kernel pacing falls back
+     *        to "user" where the backend cannot set the cap.
+     */
+    void setPacing(const std::string& mechanism);
+
+    /**
+     * @brief Gets the requested pacing mechanism.
+     * @return "user" or "kernel".
+     */
+    std::string getPacing() const;
+
 private:
     /**< The size of each data packet in bytes. */
     int packetSize;
     /**< Number of packets to send during the test (client-side). 0 means unlimited. */
     int numPackets;
+    /**< Sending time per phase in seconds. 0 means no time limit. */
+    double testDuration;
+    /**< Warm-up seconds per phase excluded from the statistics. Confirmed by the server. */
+    double omitSeconds;
     /**< Optional interval between sends in milliseconds. 0 means no delay. */
     int sendIntervalMs;
     /**< The network protocol to be used (e.g., "TCP"). */
@@ -160,6 +348,32 @@ private:
     TestMode mode;
     /**< Whether to save logs to a file. */
     bool saveLogs;
+    /**< Longest time the logger holds formatted lines before writing them out. */
+    int logFlushMs;
+    /**< Least severe messages logged ("error", "warning", "info", "debug"). */
+    std::string logLevel;
+    /**< Format of saved log files ("text", "binary"). */
+    std::string logFormat;
     /**< Timeout for waiting on CONFIG_ACK during client handshake. */
     int handshakeTimeoutMs;
+    /**< Local network backend selection. Not applied from the peer's config. */
+    std::string networkBackend;
+    /**< Number of parallel data connections. numPackets applies to each stream. */
+    int parallelStreams;
+    /**< Request zero-copy sends for data packets. Applies to both senders. */
+    bool zeroCopy;
+    /**< Packets assembled into one send buffer. Applies to both senders. */
+    int sendBatchSize;
+    /**< Checksum algorithm for data packets ("sum", "crc32c", "xxh3"). Negotiated in the handshake. */
+    std::string integrity;
+    /**< Payload verification policy of the receivers ("full", "header-only", "sampled"). */
+    std::string verification;
+    /**< Every Nth packet is checked under the "sampled" policy. */
+    int verificationSampleInterval;
+    /**< Paced send rate per stream in bits per second; 0 is unlimited. Applies to both senders. */
+    long long bitrate;
+    /**< Busy-wait pacing gaps below 10 us instead of sleeping. Applies to both senders. */
+    bool pacingBusyWait;
+    /**< Pacing mechanism for bitrate ("user", "kernel"). Applies to both senders. */
+    std::string pacing;
 };
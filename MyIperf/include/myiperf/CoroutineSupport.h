@@ -1,10 +1,15 @@
 #pragma once
 
+#include "myiperf/TimerService.h"
+
+#include <atomic>
 #include <coroutine>
 #include <exception>
 #include <iostream>
 #include <chrono>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 /**
  * @brief MyIperf에서 사용하는 최소 C++20 coroutine Task.
@@ -146,17 +151,18 @@ struct Task {
 };
 
 /**
- * @brief 지정한 시간 동안 coroutine을 멈추는 단순 delay awaiter.
+ * @brief 지정한 시간 동안 coroutine을 멈추는 delay awaiter.
  *
- * 이 구현은 확장성보다 이해하기 쉬운 구조를 우선한다.
- * delay를 호출할 때마다 detached sleeper thread를 하나 만들고, 시간이 지나면
- * 그 thread가 coroutine을 다시 resume한다. 현재 send interval 용도로는
- * 따라가기 쉽지만, 대량 timer scheduler로 쓰기 좋은 구조는 아니다.
+ * 예전에는 delay마다 detached sleeper thread를 만들었지만, 이제는 process 공용
+ * TimerService에 deadline을 등록한다. timer thread 하나가 가장 이른 deadline까지
+ * 잠들었다가 coroutine을 resume하므로 delay 한 번에 thread 생성 비용이 없다.
+ * coroutine은 timer thread에서 재개된다. I/O thread에서 재개되어야 하는 data path는
+ * NetworkInterface::sleepUntil()을 사용한다.
  */
 struct DelayAwaiter {
     std::chrono::steady_clock::time_point endTime;
 
-    DelayAwaiter(std::chrono::milliseconds duration)
+    DelayAwaiter(std::chrono::steady_clock::duration duration)
         : endTime(std::chrono::steady_clock::now() + duration) {}
 
     bool await_ready() const noexcept {
@@ -165,17 +171,12 @@ struct DelayAwaiter {
     }
 
     void await_suspend(std::coroutine_handle<> h) const {
-        // 현재 coroutine은 멈춘다. detached thread가 목표 시간까지 sleep한 뒤,
-        // 같은 coroutine handle을 resume한다.
-        std::thread([h, endTime = this->endTime]() {
-            auto now = std::chrono::steady_clock::now();
-            if (endTime > now) {
-                std::this_thread::sleep_until(endTime);
-            }
+        // 현재 coroutine은 멈춘다. timer thread가 목표 시간에 같은 handle을 resume한다.
+        TimerService::shared().schedule(endTime, [h]() {
             if (!h.done()) {
                 h.resume();
             }
-        }).detach();
+        });
     }
 
     void await_resume() const noexcept {}
@@ -186,6 +187,90 @@ struct DelayAwaiter {
  * @param duration 멈출 시간.
  * @return co_await 가능한 DelayAwaiter.
  */
-inline DelayAwaiter delay(std::chrono::milliseconds duration) {
+inline DelayAwaiter delay(std::chrono::steady_clock::duration duration) {
     return DelayAwaiter(duration);
 }
+
+/**
+ * @brief 여러 Task를 동시에 시작하고 모두 끝날 때까지 부모를 멈추는 awaiter.
+ *
+ * 병렬 stream처럼 서로 다른 NetworkInterface worker thread에서 재개되는 Task를
+ * 한 번에 기다릴 때 사용한다. 각 Task는 wrapper coroutine 안에서 co_await되고,
+ * 마지막으로 끝난 wrapper가 부모를 재개한다.
+ *
+ * remaining은 Task 개수 + 1로 시작한다. 추가된 1은 await_suspend() 자신의 몫이라서,
+ * 모든 Task를 시작하기 전에 부모가 먼저 재개되는 일이 없다.
+ * 자식에서 발생한 첫 번째 예외는 await_resume()에서 다시 던진다.
+ */
+class WhenAllAwaiter {
+public:
+    explicit WhenAllAwaiter(std::vector<Task> tasks) : tasks(std::move(tasks)) {}
+    WhenAllAwaiter(const WhenAllAwaiter&) = delete;
+    WhenAllAwaiter& operator=(const WhenAllAwaiter&) = delete;
+
+    bool await_ready() const noexcept { return tasks.empty(); }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        parent = handle;
+        remaining.store(tasks.size() + 1, std::memory_order_relaxed);
+        wrappers.reserve(tasks.size());
+        for (auto& task : tasks) {
+            wrappers.push_back(runChild(this, task));
+            wrappers.back().start();
+        }
+        // 모든 자식이 이미 동기적으로 끝났다면 멈추지 않고 바로 이어간다.
+        return remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void await_resume() {
+        if (firstException) {
+            std::rethrow_exception(firstException);
+        }
+    }
+
+private:
+    // wrapper가 끝날 때 도착을 알리는 awaiter.
+    // 카운터는 wrapper가 완전히 suspend된 뒤에 줄어들기 때문에, 부모가 재개되어
+    // wrapper frame을 destroy해도 아직 실행 중인 wrapper가 남지 않는다.
+    // 마지막으로 도착한 wrapper는 symmetric transfer로 부모를 재개한다.
+    struct Arrive {
+        WhenAllAwaiter* self;
+        bool await_ready() const noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<>) const noexcept {
+            std::coroutine_handle<> parent = self->parent;
+            if (self->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                return parent;
+            }
+            return std::noop_coroutine();
+        }
+        void await_resume() const noexcept {}
+    };
+
+    static Task runChild(WhenAllAwaiter* self, Task& task) {
+        try {
+            co_await task;
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(self->exceptionMutex);
+            if (!self->firstException) {
+                self->firstException = std::current_exception();
+            }
+        }
+        co_await Arrive{self};
+    }
+
+    std::vector<Task> tasks;
+    std::vector<Task> wrappers;
+    std::atomic<size_t> remaining{0};
+    std::coroutine_handle<> parent{nullptr};
+    std::mutex exceptionMutex;
+    std::exception_ptr firstException{nullptr};
+};
+
+/**
+ * @brief co_await whenAll(...) 형태로 쓰기 위한 helper 함수.
+ * @param tasks 동시에 실행할 Task 목록.
+ * @return 모든 Task가 끝나면 재개되는 WhenAllAwaiter.
+ */
+inline WhenAllAwaiter whenAll(std::vector<Task> tasks) {
+    return WhenAllAwaiter(std::move(tasks));
+}
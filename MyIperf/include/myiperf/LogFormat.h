@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief Compile-time checked format strings for the MYIPERF_LOG_* macros.
+ *
+ * A format string is plain text with "{}" placeholders, "{:.N}" for a
+ * floating-point argument printed with N decimals, and "{{" / "}}" for literal
+ * braces. LogFormat checks it against the argument types while compiling, so
+ * a wrong number of arguments or an unsupported argument type does not build.
+ *
+ * Arguments are not turned into text by the caller. encode() writes the
+ * address of the format string and the raw argument values into a byte
+ * buffer that travels through the log ring; render() builds the text on the
+ * logger thread. Supported arguments are integers, floating-point values,
+ * bool, char and anything convertible to std::string_view.
+ */
+namespace LogFormatting {
+
+enum class ArgKind : uint8_t {
+    Signed,
+    Unsigned,
+    Floating,
+    Boolean,
+    Character,
+    String
+};
+
+/** @brief Longest string argument kept; longer ones are cut. */
+constexpr size_t kMaxStringBytes = 4096;
+/** @brief Decimals of a floating-point argument in a plain "{}" (as std::to_string). */
+constexpr int kDefaultPrecision = 6;
+/** @brief Largest N accepted in "{:.N}". */
+constexpr int kMaxPrecision = 17;
+
+template <typename T>
+constexpr ArgKind kindOf() {
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    if constexpr (std::is_same_v<U, bool>) {
+        return ArgKind::Boolean;
+    } else if constexpr (std::is_same_v<U, char>) {
+        return ArgKind::Character;
+    } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+        return ArgKind::Signed;
+    } else if constexpr (std::is_integral_v<U>) {
+        return ArgKind::Unsigned;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return ArgKind::Floating;
+    } else {
+        static_assert(std::is_convertible_v<const U&, std::string_view>,
+                      "Log arguments must be numbers, bool, char or strings; cast enums explicitly.");
+        return ArgKind::String;
+    }
+}
+
+/**
+ * @brief Finds the placeholder starting at format[open] ('{').
+ * @param precision Set to the N of "{:.N}", or -1 for "{}".
+ * @return Index of the closing '}', or npos if the placeholder is malformed.
+ */
+constexpr size_t parsePlaceholder(std::string_view format, size_t open, int& precision) {
+    const size_t close = format.find('}', open);
+    if (close == std::string_view::npos) {
+        return close;
+    }
+    const std::string_view spec = format.substr(open + 1, close - open - 1);
+    precision = -1;
+    if (spec.empty()) {
+        return close;
+    }
+    if (spec.size() < 3 || spec.size() > 4 || spec[0] != ':' || spec[1] != '.') {
+        return std::string_view::npos;
+    }
+    int value = 0;
+    for (size_t i = 2; i < spec.size(); ++i) {
+        if (spec[i] < '0' || spec[i] > '9') {
+            return std::string_view::npos;
+        }
+        value = value * 10 + (spec[i] - '0');
+    }
+    if (value > kMaxPrecision) {
+        return std::string_view::npos;
+    }
+    precision = value;
+    return close;
+}
+
+// Never defined: reaching one while checking a format string at compile time
+// is what makes the build fail, and its name says why.
+void formatStringHasTooFewArguments();
+void formatStringHasTooManyArguments();
+void formatStringHasMalformedPlaceholder();
+void precisionNeedsFloatingPointArgument();
+
+template <typename... Args>
+consteval void check(std::string_view format) {
+    constexpr ArgKind kinds[] = {kindOf<Args>()..., ArgKind::String};
+    size_t next = 0;
+    for (size_t i = 0; i < format.size(); ++i) {
+        if (format[i] == '}') {
+            if (i + 1 < format.size() && format[i + 1] == '}') {
+                ++i;
+                continue;
+            }
+            formatStringHasMalformedPlaceholder();
+        }
+        if (format[i] != '{') {
+            continue;
+        }
+        if (i + 1 < format.size() && format[i + 1] == '{') {
+            ++i;
+            continue;
+        }
+        int precision = -1;
+        const size_t close = parsePlaceholder(format, i, precision);
+        if (close == std::string_view::npos) {
+            formatStringHasMalformedPlaceholder();
+        }
+        if (next == sizeof...(Args)) {
+            formatStringHasTooFewArguments();
+        }
+        if (precision >= 0 && kinds[next] != ArgKind::Floating) {
+            precisionNeedsFloatingPointArgument();
+        }
+        ++next;
+        i = close;
+    }
+    if (next != sizeof...(Args)) {
+        formatStringHasTooManyArguments();
+    }
+}
+
+} // namespace LogFormatting
+
+/**
+ * @class LogFormat
+ * @brief A format string checked at compile time against the argument types Args.
+ *
+ * Only constructible from a constant expression, normally a string literal,
+ * so the text it points to lives for the whole run.
+ */
+template <typename... Args>
+class LogFormat {
+public:
+    template <typename S>
+        requires std::is_convertible_v<const S&, std::string_view>
+    consteval LogFormat(const S& format) : text(format) {
+        LogFormatting::check<Args...>(text);
+    }
+
+    std::string_view text;
+};
+
+namespace LogFormatting {
+
+template <typename T>
+void appendRaw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+void encodeArg(std::string& out, const T& value) {
+    constexpr ArgKind kind = kindOf<T>();
+    out.push_back(static_cast<char>(kind));
+    if constexpr (kind == ArgKind::Signed) {
+        appendRaw(out, static_cast<int64_t>(value));
+    } else if constexpr (kind == ArgKind::Unsigned) {
+        appendRaw(out, static_cast<uint64_t>(value));
+    } else if constexpr (kind == ArgKind::Floating) {
+        appendRaw(out, static_cast<double>(value));
+    } else if constexpr (kind == ArgKind::Boolean || kind == ArgKind::Character) {
+        out.push_back(static_cast<char>(value));
+    } else {
+        const std::string_view view(value);
+        const uint32_t length = static_cast<uint32_t>(std::min(view.size(), kMaxStringBytes));
+        appendRaw(out, length);
+        out.append(view.data(), length);
+    }
+}
+
+/** @brief Bytes encode() writes before the arguments: the format string's address and length. */
+constexpr size_t kFormatHeaderBytes = sizeof(const char*) + sizeof(uint32_t);
+
+/**
+ * @brief Replaces out with the format string's address and the encoded arguments.
+ */
+template <typename... Args>
+void encode(std::string& out, std::string_view format, const Args&... args) {
+    out.clear();
+    appendRaw(out, format.data());
+    appendRaw(out, static_cast<uint32_t>(format.size()));
+    (encodeArg(out, args), ...);
+}
+
+/**
+ * @brief Appends the text of a buffer written by encode() in this process.
+ * A buffer cut short (e.g. by the log ring's size limit) renders as far as it goes.
+ */
+void render(std::string& out, std::string_view encoded);
+
+/**
+ * @brief The format string of a buffer written by encode() in this process;
+ *        empty if the buffer is too short to hold it.
+ */
+std::string_view formatOf(std::string_view encoded);
+
+/**
+ * @brief Appends the text of format filled in from arguments, the bytes that
+ *        follow the first kFormatHeaderBytes of an encode() buffer. Also takes
+ *        formats and arguments read back from a binary log file, so a
+ *        malformed format ends the text instead of being trusted.
+ */
+void renderArguments(std::string& out, std::string_view format, std::string_view arguments);
+
+} // namespace LogFormatting
@@ -3,14 +3,31 @@
 #include <string>
 #include <iostream>
 #include <mutex>
-#include <condition_variable>
 #include <thread>
-#include <deque>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <filesystem>
+#include <type_traits>
 #include "myiperf/Protocol.h"
 #include "myiperf/Config.h"
+#include "myiperf/LogFormat.h"
+
+class LogRing;
+class BinaryLogWriter;
+
+/**
+ * @brief Severity of a log record. The MYIPERF_LOG_* macros name it; for
+ * Logger::log() it is taken from the message prefix ("Error:", "Warning:",
+ * "Debug:"; anything else is Info). Lower values are more severe.
+ */
+enum class LogLevel : uint8_t {
+    Error,
+    Warning,
+    Info,
+    Debug
+};
 
 /**
  * @class Logger
@@ -18,6 +35,17 @@
  *
  * This static class provides a simple logging framework that queues messages
  * from multiple threads and writes them to the console and optional log files.
+ * log() copies the message and a steady_clock timestamp into a lock-free ring
+ * (LogRing) and returns; the worker thread formats the timestamp and writes
+ * the line. When the ring is full the message is dropped and counted rather
+ * than making the caller wait.
+ *
+ * With --log-format binary the saved log is written as memory-mapped binary
+ * segments (BinaryLogWriter) instead of a text file; the worker then formats
+ * timestamps only for the console and the pipe.
+ *
+ * New code logs through the MYIPERF_LOG_* macros below, which check the level
+ * before evaluating any argument and defer formatting to the worker.
  */
 class Logger {
 public:
@@ -38,6 +66,28 @@ public:
      */
     static void log(const std::string& message);
 
+    /**
+     * @brief Checks the --log-level threshold. Cheap enough to call before
+     *        building a message.
+     */
+    static bool isEnabled(LogLevel level) {
+        return static_cast<uint8_t>(level) <= maxLevel.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Logs a formatted message; normally reached through the MYIPERF_LOG_* macros.
+     *
+     * The arguments are copied as values next to the address of the format
+     * string, and the line ("Info: " etc. plus the formatted text) is built on
+     * the worker thread. Does not check isEnabled().
+     */
+    template <typename... Args>
+    static void write(LogLevel level, LogFormat<std::type_identity_t<Args>...> format, const Args&... args) {
+        std::string& encoded = encodeBuffer();
+        LogFormatting::encode(encoded, format.text, args...);
+        enqueueFormatted(level, encoded);
+    }
+
     /**
      * @brief Writes the final report of the test to the log.
      * @param role The role of the current instance (Client or Server).
@@ -59,12 +109,47 @@ public:
      */
     static bool isConsoleOutputEnabled();
 
+    /**
+     * @brief The prefix write() puts before a formatted message, e.g. "Info: ".
+     */
+    static const char* levelTag(LogLevel level);
+
+    /**
+     * @brief Number of messages dropped because the ring was full, over the process lifetime.
+     */
+    static uint64_t droppedMessages();
+
 private:
     /**
      * @brief The main function for the logger worker thread.
      */
     static void logWorker();
 
+    /**
+     * @brief Per-thread scratch buffer for write(); keeps its capacity between calls.
+     */
+    static std::string& encodeBuffer();
+
+    /**
+     * @brief Queues a buffer written by LogFormatting::encode().
+     */
+    static void enqueueFormatted(LogLevel level, const std::string& encoded);
+
+    /**
+     * @brief Prints a message on the calling thread while the worker is not running.
+     */
+    static void logImmediately(const std::string& message);
+
+    /**
+     * @brief Writes a batch of formatted lines to every enabled output, one call per output.
+     */
+    static void writeBatch(const std::string& lines, const std::string& coloredLines);
+
+    /**
+     * @brief True if a line logged at time goes to the console, the text log file or the pipe.
+     */
+    static bool hasTextOutput(std::chrono::steady_clock::time_point time);
+
     /**
      * @brief The main function for the pipe connection worker thread.
      */
@@ -77,12 +162,8 @@ private:
     static void manageLogRotation(const std::string& mode);
 
     // Logging framework members
-    /**< Mutex to protect the message queue. */
-    static std::mutex queueMutex;
-    /**< Condition variable to signal the logger worker thread. */
-    static std::condition_variable cv;
-    /**< The queue of messages to be logged. */
-    static std::deque<std::string> messageQueue;
+    /**< Records waiting for the worker thread. */
+    static LogRing ring;
     /**< The logger worker thread. */
     static std::thread workerThread;
     /**< Mutex guarding start/stop transitions. */
@@ -91,6 +172,8 @@ private:
     static std::atomic<bool> started;
     /**< Flag to control the running state of the logger worker loop. */
     static std::atomic<bool> running;
+    /**< Least severe LogLevel that is logged (--log-level). */
+    static std::atomic<uint8_t> maxLevel;
 
     // File logging members
     /**< The output file stream for the log file. */
@@ -101,6 +184,10 @@ private:
     static const std::string logDirectory;
     /**< Mutex protecting direct output when logger is not running. */
     static std::mutex immediateMutex;
+    /**< Binary log segments (--log-format binary). Worker thread only while running. */
+    static BinaryLogWriter binaryLog;
+    /**< Longest time the worker holds formatted lines before writing them. */
+    static std::chrono::milliseconds flushInterval;
 
     // Pipe logging members
     static std::string pipeName;
@@ -108,7 +195,50 @@ private:
     static std::thread pipeThread;
 #ifdef _WIN32
     static void* hPipe; 
+#else
+    /**< Write end of the FIFO while a reader is attached, or -1. Worker thread only. */
+    static int pipeFd;
+    /**< Rest of a line the full FIFO took only part of; written before the next batch. */
+    static std::string pipeCarry;
+    /**< Earliest time the worker tries to open the FIFO again. */
+    static std::chrono::steady_clock::time_point nextPipeOpen;
 #endif
 
     static bool consoleOutput;  // 콘솔 출력 활성화 플래그
 };
+
+/**
+ * Least severe level compiled in: 0 Error, 1 Warning, 2 Info, 3 Debug. Debug
+ * statements are compiled in only with MYIPERF_ENABLE_DEBUG_LOGS. Statements
+ * above this level compile to nothing, but their format strings are still
+ * checked.
+ */
+#ifndef MYIPERF_COMPILED_LOG_LEVEL
+#if defined(MYIPERF_ENABLE_DEBUG_LOGS) && MYIPERF_ENABLE_DEBUG_LOGS
+#define MYIPERF_COMPILED_LOG_LEVEL 3
+#else
+#define MYIPERF_COMPILED_LOG_LEVEL 2
+#endif
+#endif
+
+/**
+ * Logs a message whose arguments are evaluated only if the level is compiled
+ * in and enabled at run time, e.g.
+ *
+ *   MYIPERF_LOG_INFO("Data stream {} connected from {}", index, clientIP);
+ *
+ * writes "Info: Data stream 1 connected from 127.0.0.1".
+ */
+#define MYIPERF_LOG(level, ...)                                                     \
+    do {                                                                            \
+        if constexpr (static_cast<int>(level) <= MYIPERF_COMPILED_LOG_LEVEL) {      \
+            if (Logger::isEnabled(level)) {                                         \
+                Logger::write(level, __VA_ARGS__);                                  \
+            }                                                                       \
+        }                                                                           \
+    } while (false)
+
+#define MYIPERF_LOG_ERROR(...) MYIPERF_LOG(LogLevel::Error, __VA_ARGS__)
+#define MYIPERF_LOG_WARNING(...) MYIPERF_LOG(LogLevel::Warning, __VA_ARGS__)
+#define MYIPERF_LOG_INFO(...) MYIPERF_LOG(LogLevel::Info, __VA_ARGS__)
+#define MYIPERF_LOG_DEBUG(...) MYIPERF_LOG(LogLevel::Debug, __VA_ARGS__)
@@ -1,19 +1,30 @@
 // NetworkInterface.h
 #pragma once
 
+#include "myiperf/NetworkIoStats.h"
+#include "myiperf/TimerService.h"
+
 #include <string>
 #include <vector>
 #include <functional>
 #include <coroutine>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <span>
 
 /**
  * Backend callbacks are implementation details used to bridge native async I/O
- * completion events into coroutine awaiters.
+ * completion events into coroutine awaiters. A RecvCallback's data is only valid
+ * during the call and may be longer than bytesReceived.
  */
 using RecvCallback = std::function<void(const std::vector<char>& data, size_t bytesReceived)>;
+using RecvIntoCallback = std::function<void(size_t bytesReceived)>;
 using SendCallback = std::function<void(size_t bytesSent)>;
 using ConnectCallback = std::function<void(bool success)>;
 using AcceptCallback = std::function<void(bool success, const std::string& clientIP, int clientPort)>;
+using TimerCallback = std::function<void()>;
 
 /**
  * @class NetworkInterface
@@ -51,6 +62,37 @@ public:
      */
     virtual void close() = 0;
 
+    /**
+     * @brief Returns the syscall counters collected by the backend so far.
+     * Backends that do not count return an empty NetworkIoStats.
+     */
+    virtual NetworkIoStats getIoStats() const { return {}; }
+
+    /**
+     * @brief Requests zero-copy sends (MSG_ZEROCOPY) on the connected socket.
+     * Send buffers then stay pinned until the kernel reports the transmission.
+     * @param enabled True to use zero-copy sends, false for regular copying sends.
+     * @return False if zero-copy was requested but the backend or socket cannot provide it.
+     */
+    virtual bool setZeroCopySend(bool enabled) { return !enabled; }
+
+    /**
+     * @brief Caps the send rate of the connected socket in the kernel (SO_MAX_PACING_RATE).
+     * The fq qdisc, or TCP's internal pacing where fq is not installed, then spaces
+     * the segments, so the sender may write as fast as the socket accepts data.
+     * @param bytesPerSecond The cap; 0 removes it.
+     * @return False if a cap was requested but the backend or socket cannot apply it.
+     */
+    virtual bool setPacingRate(uint64_t bytesPerSecond) { return bytesPerSecond == 0; }
+
+    /**
+     * @brief Tells the backend that later receiveInto() spans lie inside memory,
+     * so it can register that memory with the kernel once instead of per receive.
+     * The memory must stay valid until the next call or close(); an empty span
+     * withdraws it. Backends without registered buffers ignore the call.
+     */
+    virtual void registerReceiveMemory(std::span<char> memory) { (void)memory; }
+
     // --- Coroutine Awaitables ---
 
     struct ConnectAwaiter {
@@ -104,7 +146,8 @@ public:
 
         bool await_ready() { return false; }
         void await_suspend(std::coroutine_handle<> h) {
-            net->doAsyncSend(data, [this, h](size_t sent) mutable {
+            // The backend takes ownership of the bytes; no further copy is made here.
+            net->doAsyncSend(std::move(data), [this, h](size_t sent) mutable {
                 bytesSent = sent;
                 h.resume();
             });
@@ -114,7 +157,7 @@ public:
 
     struct ReceiveResult {
         std::vector<char> data;
-        size_t bytesReceived;
+        size_t bytesReceived = 0;
     };
 
     struct ReceiveAwaiter {
@@ -127,14 +170,75 @@ public:
 
         bool await_ready() { return false; }
         void await_suspend(std::coroutine_handle<> h) {
+            // The backend may lend a pooled buffer larger than the data; copy only the
+            // received bytes, since the buffer is reused once this callback returns.
             net->doAsyncReceive(bufferSize, [this, h](const std::vector<char>& d, size_t b) mutable {
-                result = {d, b};
+                result.data.assign(d.begin(), d.begin() + static_cast<std::ptrdiff_t>(b));
+                result.bytesReceived = b;
                 h.resume();
             });
         }
         ReceiveResult await_resume() { return result; }
     };
 
+    // --- Buffer-lending Awaitables ---
+    //
+    // The caller lends the span for exactly the duration of the co_await: the
+    // backend may read (send) or write (receive) it from await_suspend until the
+    // coroutine resumes, and releases it by resuming. It keeps no reference
+    // afterwards, so the caller can reuse the memory for the next operation.
+
+    struct SendSpanAwaiter {
+        NetworkInterface* net;
+        std::span<const char> data;
+        size_t bytesSent = 0;
+
+        SendSpanAwaiter(NetworkInterface* n, std::span<const char> d)
+            : net(n), data(d) {}
+
+        bool await_ready() { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            net->doAsyncSendSpan(data, [this, h](size_t sent) mutable {
+                bytesSent = sent;
+                h.resume();
+            });
+        }
+        size_t await_resume() { return bytesSent; }
+    };
+
+    struct ReceiveIntoAwaiter {
+        NetworkInterface* net;
+        std::span<char> buffer;
+        size_t bytesReceived = 0;
+
+        ReceiveIntoAwaiter(NetworkInterface* n, std::span<char> b)
+            : net(n), buffer(b) {}
+
+        bool await_ready() { return false; }
+        void await_suspend(std::coroutine_handle<> h) {
+            net->doAsyncReceiveInto(buffer, [this, h](size_t b) mutable {
+                bytesReceived = b;
+                h.resume();
+            });
+        }
+        /** @return Bytes written to the start of the buffer; 0 if the connection closed or failed. */
+        size_t await_resume() { return bytesReceived; }
+    };
+
+    struct SleepAwaiter {
+        NetworkInterface* net;
+        std::chrono::steady_clock::time_point deadline;
+
+        SleepAwaiter(NetworkInterface* n, std::chrono::steady_clock::time_point d)
+            : net(n), deadline(d) {}
+
+        bool await_ready() { return std::chrono::steady_clock::now() >= deadline; }
+        void await_suspend(std::coroutine_handle<> h) {
+            net->doAsyncWait(deadline, [h]() { h.resume(); });
+        }
+        void await_resume() {}
+    };
+
     // --- Coroutine Helper Methods ---
 
     ConnectAwaiter connect(const std::string& ip, int port) {
@@ -145,18 +249,63 @@ public:
         return AcceptAwaiter(this);
     }
 
-    SendAwaiter send(const std::vector<char>& data) {
-        return SendAwaiter(this, data);
+    SendAwaiter send(std::vector<char> data) {
+        return SendAwaiter(this, std::move(data));
     }
 
     ReceiveAwaiter receive(size_t bufferSize) {
         return ReceiveAwaiter(this, bufferSize);
     }
 
+    /**
+     * @brief Sends bytes owned by the caller without handing them over.
+     * Unlike send(), the data is not pinned after completion, so zero-copy
+     * sends always use send().
+     */
+    SendSpanAwaiter sendFrom(std::span<const char> data) {
+        return SendSpanAwaiter(this, data);
+    }
+
+    /**
+     * @brief Receives up to buffer.size() bytes directly into caller memory.
+     */
+    ReceiveIntoAwaiter receiveInto(std::span<char> buffer) {
+        return ReceiveIntoAwaiter(this, buffer);
+    }
+
+    /**
+     * @brief Suspends until deadline. Backends with a timer in their event loop
+     * resume the coroutine on their I/O thread and, like their other pending
+     * operations, drop it on close(); the others use TimerService.
+     */
+    SleepAwaiter sleepUntil(std::chrono::steady_clock::time_point deadline) {
+        return SleepAwaiter(this, deadline);
+    }
+
 protected:
     // Callback-based hooks implemented by platform backends.
     virtual void doAsyncConnect(const std::string& ip, int port, ConnectCallback callback) = 0;
     virtual void doAsyncAccept(AcceptCallback callback) = 0;
-    virtual void doAsyncSend(const std::vector<char>& data, SendCallback callback) = 0;
+    virtual void doAsyncSend(std::vector<char> data, SendCallback callback) = 0;
     virtual void doAsyncReceive(size_t bufferSize, RecvCallback callback) = 0;
+
+    // Timer hook. The default runs the callback on the shared TimerService thread.
+    virtual void doAsyncWait(std::chrono::steady_clock::time_point deadline, TimerCallback callback) {
+        TimerService::shared().schedule(deadline, std::move(callback));
+    }
+
+    // Buffer-lending hooks. The defaults fall back to the owning hooks and copy;
+    // backends that can use the caller's memory directly override them.
+    virtual void doAsyncSendSpan(std::span<const char> data, SendCallback callback) {
+        doAsyncSend(std::vector<char>(data.begin(), data.end()), std::move(callback));
+    }
+    virtual void doAsyncReceiveInto(std::span<char> buffer, RecvIntoCallback callback) {
+        doAsyncReceive(buffer.size(), [buffer, callback = std::move(callback)](const std::vector<char>& d, size_t b) {
+            const size_t copied = std::min(b, buffer.size());
+            if (copied > 0) {
+                std::memcpy(buffer.data(), d.data(), copied);
+            }
+            callback(copied);
+        });
+    }
 };
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "nlohmann/json.hpp"
+
+#include <string>
+
+/**
+ * @struct NetworkIoStats
+ * @brief Counts the system calls a network backend issued during a run.
+ *
+ * The counters are local to one process and are not exchanged with the peer.
+ * They exist to compare backends and I/O strategies, e.g. how many syscalls
+ * each transferred packet costs.
+ */
+struct NetworkIoStats {
+    /** @brief Backend that produced the counters ("epoll", "io_uring"); empty if the backend does not count. */
+    std::string backend;
+    /** @brief send/sendmsg/writev calls, or send operations submitted to a ring. */
+    long long sendCalls = 0;
+    /** @brief recv/accept calls, or receive operations submitted to a ring. */
+    long long recvCalls = 0;
+    /** @brief Blocking readiness/completion waits (epoll_wait, io_uring_enter with GETEVENTS). */
+    long long waitCalls = 0;
+    /** @brief Registration changes, timer arming and submit-only calls (epoll_ctl, timerfd_settime, io_uring_enter without wait). */
+    long long controlCalls = 0;
+    /** @brief Wakeups of the I/O thread (eventfd writes and drains, timerfd drains). */
+    long long wakeupCalls = 0;
+    /** @brief Send calls issued with MSG_ZEROCOPY. */
+    long long zeroCopySends = 0;
+    /** @brief Zero-copy sends the kernel reported as transmitted without copying. */
+    long long zeroCopyCompleted = 0;
+    /** @brief Zero-copy sends that fell back to copying (kernel-reported or ENOBUFS retries). */
+    long long zeroCopyCopied = 0;
+    /** @brief Receives that needed no new buffer: a reused pooled buffer or a registered one. */
+    long long recvBufferHits = 0;
+    /** @brief Receives that had to allocate a buffer. */
+    long long recvBufferMisses = 0;
+    /** @brief Receives written straight into caller memory that was not registered (receiveInto). */
+    long long recvDirect = 0;
+
+    /**
+     * @brief Total number of syscalls counted. Ring-submitted operations are
+     *        not syscalls and are excluded for the io_uring backend.
+     */
+    long long totalSyscalls() const {
+        const long long dataCalls = backend == "io_uring" ? 0 : sendCalls + recvCalls;
+        return dataCalls + waitCalls + controlCalls + wakeupCalls;
+    }
+
+    NetworkIoStats& operator+=(const NetworkIoStats& other) {
+        if (backend.empty()) {
+            backend = other.backend;
+        }
+        sendCalls += other.sendCalls;
+        recvCalls += other.recvCalls;
+        waitCalls += other.waitCalls;
+        controlCalls += other.controlCalls;
+        wakeupCalls += other.wakeupCalls;
+        zeroCopySends += other.zeroCopySends;
+        zeroCopyCompleted += other.zeroCopyCompleted;
+        zeroCopyCopied += other.zeroCopyCopied;
+        recvBufferHits += other.recvBufferHits;
+        recvBufferMisses += other.recvBufferMisses;
+        recvDirect += other.recvDirect;
+        return *this;
+    }
+};
+
+namespace nlohmann {
+
+template <>
+struct adl_serializer<NetworkIoStats> {
+    static void to_json(json& j, const NetworkIoStats& s) {
+        j = json{
+            {"backend", s.backend},
+            {"sendCalls", s.sendCalls},
+            {"recvCalls", s.recvCalls},
+            {"waitCalls", s.waitCalls},
+            {"controlCalls", s.controlCalls},
+            {"wakeupCalls", s.wakeupCalls},
+            {"totalSyscalls", s.totalSyscalls()},
+            {"zeroCopySends", s.zeroCopySends},
+            {"zeroCopyCompleted", s.zeroCopyCompleted},
+            {"zeroCopyCopied", s.zeroCopyCopied},
+            {"recvBufferHits", s.recvBufferHits},
+            {"recvBufferMisses", s.recvBufferMisses},
+            {"recvDirect", s.recvDirect},
+        };
+    }
+
+    static void from_json(const json& j, NetworkIoStats& s) {
+        j.at("backend").get_to(s.backend);
+        j.at("sendCalls").get_to(s.sendCalls);
+        j.at("recvCalls").get_to(s.recvCalls);
+        j.at("waitCalls").get_to(s.waitCalls);
+        j.at("controlCalls").get_to(s.controlCalls);
+        j.at("wakeupCalls").get_to(s.wakeupCalls);
+        if (j.contains("zeroCopySends")) {
+            j.at("zeroCopySends").get_to(s.zeroCopySends);
+            j.at("zeroCopyCompleted").get_to(s.zeroCopyCompleted);
+            j.at("zeroCopyCopied").get_to(s.zeroCopyCopied);
+        }
+        if (j.contains("recvBufferHits")) {
+            j.at("recvBufferHits").get_to(s.recvBufferHits);
+            j.at("recvBufferMisses").get_to(s.recvBufferMisses);
+        }
+        if (j.contains("recvDirect")) {
+            j.at("recvDirect").get_to(s.recvDirect);
+        }
+    }
+};
+
+} // namespace nlohmann
@@ -2,9 +2,9 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 #include "nlohmann/json.hpp"
 
-// #define DEBUG_LOG
 // #define DEBUG_PIPE
 
 /**
@@ -19,7 +19,8 @@ enum class MessageType : uint8_t {
     STATS_ACK        = 4, // An acknowledgment of receiving statistics.
     TEST_FIN         = 5, // Sent by either side to signal completion of the test phase.
     CLIENT_READY     = 6, // Sent by the client to signal it's ready for the server-to-client test.
-    SHUTDOWN_ACK     = 7  // Sent by the client to acknowledge the final stats and confirm shutdown.
+    SHUTDOWN_ACK     = 7, // Sent by the client to acknowledge the final stats and confirm shutdown.
+    OMIT_END         = 8  // Sent in-band on each data stream where the --omit warm-up window ends.
 };
 
 /**
@@ -48,12 +49,83 @@ struct TestStats {
      * Formula: (totalBytesReceived * 8) / duration / 1,000,000
      */
     double throughputMbps;
+    /**
+     * @brief Number of send calls the packet generator issued. Equals totalPacketsSent
+     * unless packets are batched (--batch). Zero for receiver-side stats.
+     */
+    long long sendOperations;
+    /**
+     * @brief Payload verification policy of the receiver that produced these stats
+     * ("full", "header-only" or "sampled"). Empty for sender-side stats and for
+     * peers that predate verification policies, which check every payload.
+     */
+    std::string verification;
+    /** @brief N of a "sampled" policy: every Nth packet is checked. 0 otherwise. */
+    int verificationSampleInterval;
+    /**
+     * @brief Data packets whose payload was checked (checksum, and content under the
+     * sum integrity algorithm). contentMismatchCount and failedChecksumCount can
+     * only count problems among these.
+     */
+    long long payloadsVerified;
+    /**
+     * @brief Send rate the generator paced to (--bitrate), in bits per second.
+     * 0 if sending was not rate limited, and for receiver-side stats.
+     */
+    long long targetBitrate;
+    /**
+     * @brief What enforced targetBitrate: "user" (the generator's token bucket) or
+     * "kernel" (SO_MAX_PACING_RATE on the socket). Empty if not rate limited.
+     */
+    std::string pacing;
+    /**
+     * @brief The --omit warm-up window, excluded from the fields above.
+     * omittedBytes and omittedPackets are sent or received depending on the side.
+     * Checksum, sequence and content errors of the window are still counted above.
+     * All zero if the phase had no warm-up window.
+     */
+    double omittedDuration;
+    long long omittedBytes;
+    long long omittedPackets;
+    /**
+     * @brief Per-stream breakdown when the test used more than one data connection.
+     * Index 0 is the primary (control) connection. Empty for single-stream tests;
+     * the fields above then hold the aggregate over all streams.
+     */
+    std::vector<TestStats> streams;
 
     /**
      * @brief Default constructor to initialize all stats to zero.
      */
     TestStats() : totalBytesSent(0), totalPacketsSent(0), totalBytesReceived(0), totalPacketsReceived(0),
-                  failedChecksumCount(0), sequenceErrorCount(0), contentMismatchCount(0), duration(0.0), throughputMbps(0.0) {}
+                  failedChecksumCount(0), sequenceErrorCount(0), contentMismatchCount(0), duration(0.0), throughputMbps(0.0),
+                  sendOperations(0), verificationSampleInterval(0), payloadsVerified(0), targetBitrate(0),
+                  omittedDuration(0.0), omittedBytes(0), omittedPackets(0) {}
+
+    /**
+     * @brief Average number of packets carried by one send call.
+     * @return totalPacketsSent / sendOperations, or 0 if nothing was sent.
+     */
+    double packetsPerSend() const {
+        return sendOperations > 0 ? static_cast<double>(totalPacketsSent) / static_cast<double>(sendOperations) : 0.0;
+    }
+
+    /**
+     * @brief Deviation of the achieved send rate from targetBitrate.
+     * @return (throughput - target) / target in percent, or 0 if not rate limited.
+     */
+    double bitrateErrorPercent() const {
+        if (targetBitrate <= 0) return 0.0;
+        const double target = static_cast<double>(targetBitrate) / 1'000'000.0;
+        return (throughputMbps - target) / target * 100.0;
+    }
+
+    /**
+     * @brief Throughput during the --omit window in Mbps, or 0 if there was none.
+     */
+    double omittedThroughputMbps() const {
+        return omittedDuration > 0 ? static_cast<double>(omittedBytes) * 8.0 / omittedDuration / 1'000'000.0 : 0.0;
+    }
 };
 
 namespace nlohmann {
@@ -80,6 +152,31 @@ namespace nlohmann {
                                  {"contentMismatchCount", s.contentMismatchCount},
                                  {"duration", s.duration},
                                  {"throughputMbps", s.throughputMbps}};
+            if (s.sendOperations > 0) {
+                j["sendOperations"] = s.sendOperations;
+                j["packetsPerSend"] = s.packetsPerSend();
+            }
+            if (s.targetBitrate > 0) {
+                j["targetBitrate"] = s.targetBitrate;
+                j["bitrateErrorPercent"] = s.bitrateErrorPercent();
+                j["pacing"] = s.pacing;
+            }
+            if (s.omittedDuration > 0) {
+                j["omitted"] = nlohmann::json{{"duration", s.omittedDuration},
+                                              {"bytes", s.omittedBytes},
+                                              {"packets", s.omittedPackets},
+                                              {"throughputMbps", s.omittedThroughputMbps()}};
+            }
+            if (!s.verification.empty()) {
+                j["verification"] = s.verification;
+                j["payloadsVerified"] = s.payloadsVerified;
+                if (s.verificationSampleInterval > 0) {
+                    j["verificationSampleInterval"] = s.verificationSampleInterval;
+                }
+            }
+            if (!s.streams.empty()) {
+                j["streams"] = s.streams;
+            }
         }
 
         /**
@@ -97,6 +194,31 @@ namespace nlohmann {
             j.at("contentMismatchCount").get_to(s.contentMismatchCount);
             j.at("duration").get_to(s.duration);
             j.at("throughputMbps").get_to(s.throughputMbps);
+            if (j.contains("sendOperations")) {
+                j.at("sendOperations").get_to(s.sendOperations);
+            }
+            if (j.contains("targetBitrate")) {
+                j.at("targetBitrate").get_to(s.targetBitrate);
+            }
+            if (j.contains("pacing")) {
+                j.at("pacing").get_to(s.pacing);
+            }
+            if (j.contains("omitted")) {
+                const json& omitted = j.at("omitted");
+                omitted.at("duration").get_to(s.omittedDuration);
+                omitted.at("bytes").get_to(s.omittedBytes);
+                omitted.at("packets").get_to(s.omittedPackets);
+            }
+            if (j.contains("verification")) {
+                j.at("verification").get_to(s.verification);
+                j.at("payloadsVerified").get_to(s.payloadsVerified);
+                if (j.contains("verificationSampleInterval")) {
+                    j.at("verificationSampleInterval").get_to(s.verificationSampleInterval);
+                }
+            }
+            if (j.contains("streams")) {
+                j.at("streams").get_to(s.streams);
+            }
         }
     };
 }
@@ -131,27 +253,108 @@ constexpr uint16_t PROTOCOL_START_CODE = 0xABCD;
 
 /**
  * @brief Calculates a simple checksum for a block of data.
+ *
+ * The checksum is the sum of all bytes modulo 2^32. It is computed with the
+ * widest SIMD kernel the CPU supports (SSE2, AVX2 or AVX-512BW, chosen once at
+ * runtime), which always yields the same value as a byte-at-a-time sum.
+ *
  * @param data A pointer to the data.
  * @param size The size of the data in bytes.
  * @return The calculated checksum.
  */
-inline uint32_t calculateChecksum(const char* data, size_t size) {
-    uint32_t sum = 0;
-    for (size_t i = 0; i < size; ++i) {
-        sum += static_cast<unsigned char>(data[i]);
+uint32_t calculateChecksum(const char* data, size_t size);
+
+/**
+ * @enum IntegrityAlgorithm
+ * @brief Selects how PacketHeader::checksum is computed for DATA_PACKETs.
+ *
+ * The client proposes an algorithm in CONFIG_HANDSHAKE and the server confirms
+ * it in CONFIG_ACK. Control packets always use SUM, because they have to be
+ * checked before and during that negotiation.
+ */
+enum class IntegrityAlgorithm : uint8_t {
+    SUM,    // Additive byte sum. Cheap, but blind to swapped or reordered bytes.
+    CRC32C, // CRC-32C (Castagnoli), using the SSE4.2 CRC32 instruction when available.
+    XXH3    // Low 32 bits of XXH3-64.
+};
+
+/**
+ * @brief Computes PacketHeader::checksum for a payload with the given algorithm.
+ * For IntegrityAlgorithm::SUM this is calculateChecksum().
+ */
+uint32_t calculateIntegrity(IntegrityAlgorithm algorithm, const char* data, size_t size);
+
+/** @brief Name used in configs and the handshake: "sum", "crc32c" or "xxh3". */
+const char* integrityAlgorithmName(IntegrityAlgorithm algorithm);
+
+/**
+ * @brief Parses an algorithm name as returned by integrityAlgorithmName().
+ * @return False, leaving algorithm unchanged, if the name is unknown.
+ */
+bool parseIntegrityAlgorithm(const std::string& name, IntegrityAlgorithm& algorithm);
+
+/**
+ * @enum VerificationPolicy
+ * @brief How much of each received DATA_PACKET payload the receiver checks.
+ *
+ * Header checks (start code, payload size, sequence) and control packets are
+ * never skipped. Part of the config sent in CONFIG_HANDSHAKE, so both
+ * receivers of a run apply the same policy.
+ */
+enum class VerificationPolicy : uint8_t {
+    FULL,        // Checksum, and content under the sum, of every payload.
+    HEADER_ONLY, // No payload checks; the receiver only drains and counts.
+    SAMPLED      // Full checks on packets whose counter is a multiple of N.
+};
+
+/** @brief Name used in configs and results: "full", "header-only" or "sampled". */
+inline const char* verificationPolicyName(VerificationPolicy policy) {
+    switch (policy) {
+    case VerificationPolicy::HEADER_ONLY:
+        return "header-only";
+    case VerificationPolicy::SAMPLED:
+        return "sampled";
+    case VerificationPolicy::FULL:
+    default:
+        return "full";
+    }
+}
+
+/**
+ * @brief Parses a policy name as returned by verificationPolicyName().
+ * @return False, leaving policy unchanged, if the name is unknown.
+ */
+inline bool parseVerificationPolicy(const std::string& name, VerificationPolicy& policy) {
+    for (const auto candidate : {VerificationPolicy::FULL, VerificationPolicy::HEADER_ONLY, VerificationPolicy::SAMPLED}) {
+        if (name == verificationPolicyName(candidate)) {
+            policy = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/** @brief Human-readable policy, e.g. "sampled 1/64", for logs. */
+inline std::string describeVerification(const std::string& policy, int sampleInterval) {
+    if (policy == verificationPolicyName(VerificationPolicy::SAMPLED)) {
+        return policy + " 1/" + std::to_string(sampleInterval);
     }
-    return sum;
+    return policy;
 }
 
 /**
  * @brief Verifies the integrity and validity of a packet.
  * @param header The packet header.
  * @param payload A pointer to the packet's payload data.
+ * @param dataIntegrity The negotiated algorithm for DATA_PACKETs; other packets use SUM.
  * @return True if the packet is valid, false otherwise.
  */
-inline bool verifyPacket(const PacketHeader& header, const char* payload) {
+inline bool verifyPacket(const PacketHeader& header, const char* payload,
+                         IntegrityAlgorithm dataIntegrity = IntegrityAlgorithm::SUM) {
     if (header.startCode != PROTOCOL_START_CODE) return false;
-    return header.checksum == calculateChecksum(payload, header.payloadSize);
+    const IntegrityAlgorithm algorithm =
+        header.messageType == MessageType::DATA_PACKET ? dataIntegrity : IntegrityAlgorithm::SUM;
+    return header.checksum == calculateIntegrity(algorithm, payload, header.payloadSize);
 }
 
 /**
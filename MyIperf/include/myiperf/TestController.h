@@ -16,6 +16,7 @@
 
 class ControlChannel;
 class ControlMessageBus;
+class DataStreamSet;
 class NetworkInterface;
 class PacketGenerator;
 class PacketReceiver;
@@ -113,6 +114,16 @@ private:
     std::unique_ptr<ControlMessageBus> controlMessages;
     /** @brief User-facing control protocol API for sessions. */
     std::unique_ptr<ControlChannel> controlChannel;
+    /** @brief Extra data connections of a parallel-stream test (stream 1..N-1). */
+    std::unique_ptr<DataStreamSet> dataStreams;
+    /** @brief Backend name the current networkInterface was created for. */
+    std::string m_networkBackend = "default";
+
+    /**
+     * @brief Recreates the network interface and the components bound to it.
+     * @param backend The backend name passed to createNetworkInterface().
+     */
+    void rebuildNetworkComponents(const std::string& backend);
     
     // --- State Management ---
     /** @brief The current state of the test. */
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "myiperf/Config.h"
+#include "myiperf/NetworkIoStats.h"
 #include "myiperf/Protocol.h"
 
 #include "nlohmann/json.hpp"
@@ -28,8 +29,13 @@ struct TestRunResult {
     std::string failureReason;
     std::string resultExportWarning;
     Config config;
+    /** Data packet integrity algorithm in effect after the handshake ("sum", "crc32c", "xxh3"). */
+    std::string integrity;
+    /** Receive-side payload verification policy, e.g. "full" or "sampled 1/64". */
+    std::string verification;
     TestPhaseResult phase1;
     TestPhaseResult phase2;
+    NetworkIoStats ioStats;
 };
 
 namespace nlohmann {
@@ -73,8 +79,11 @@ struct adl_serializer<TestRunResult> {
             {"failureReason", r.failureReason},
             {"resultExportWarning", r.resultExportWarning},
             {"config", r.config.toJson()},
+            {"integrity", r.integrity},
+            {"verification", r.verification},
             {"phase1", r.phase1},
             {"phase2", r.phase2},
+            {"ioStats", r.ioStats},
         };
     }
 
@@ -91,8 +100,17 @@ struct adl_serializer<TestRunResult> {
             j.at("resultExportWarning").get_to(r.resultExportWarning);
         }
         r.config = Config::fromJson(j.at("config"));
+        if (j.contains("integrity")) {
+            j.at("integrity").get_to(r.integrity);
+        }
+        if (j.contains("verification")) {
+            j.at("verification").get_to(r.verification);
+        }
         j.at("phase1").get_to(r.phase1);
         j.at("phase2").get_to(r.phase2);
+        if (j.contains("ioStats")) {
+            j.at("ioStats").get_to(r.ioStats);
+        }
     }
 };
 
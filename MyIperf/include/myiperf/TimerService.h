@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @class TimerService
+ * @brief Runs callbacks at steady_clock deadlines on one shared timer thread.
+ *
+ * All timers of the process share a single thread that sleeps until the
+ * earliest deadline, so scheduling a timer costs a heap insertion instead of
+ * a thread. Callbacks run on the timer thread and should only hand work off,
+ * e.g. resume a coroutine. Network backends that can wait on timers in their
+ * own event loop (NetworkInterface::sleepUntil) do so instead, which resumes
+ * the coroutine on the I/O thread.
+ */
+class TimerService {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;
+
+    /**
+     * @brief The process-wide instance; its thread starts with the first timer.
+     */
+    static TimerService& shared();
+
+    TimerService();
+    ~TimerService();
+    TimerService(const TimerService&) = delete;
+    TimerService& operator=(const TimerService&) = delete;
+
+    /**
+     * @brief Runs callback once deadline has passed.
+     * @return An ID for cancel(); never 0.
+     */
+    TimerId schedule(Clock::time_point deadline, std::function<void()> callback);
+
+    /**
+     * @brief Prevents a scheduled callback from running.
+     * If the callback is running on the timer thread right now, waits until
+     * it returns, so state the callback uses may be destroyed afterwards.
+     * Must not be called with a lock the callback takes.
+     * @return True if the timer was pending; false if it already fired or
+     *         was cancelled before.
+     */
+    bool cancel(TimerId id);
+
+private:
+    struct Entry {
+        Clock::time_point deadline;
+        TimerId id;
+        std::function<void()> callback;
+    };
+    struct LaterDeadline {
+        bool operator()(const Entry& a, const Entry& b) const {
+            return a.deadline > b.deadline || (a.deadline == b.deadline && a.id > b.id);
+        }
+    };
+
+    void run();
+
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::priority_queue<Entry, std::vector<Entry>, LaterDeadline> timers;
+    /** IDs in timers that have not been cancelled. */
+    std::unordered_set<TimerId> pending;
+    TimerId nextId = 1;
+    /** ID whose callback is running, or 0. */
+    TimerId firing = 0;
+    std::condition_variable firingDone;
+    bool stopping = false;
+    std::thread thread;
+};
@@ -0,0 +1,303 @@
+#include "BinaryLog.h"
+
+#include "myiperf/LogFormat.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+/**< Records larger than this are treated as corruption by the reader. */
+constexpr size_t kMaxRecordBytes = 1024 * 1024;
+
+std::string systemErrorText() {
+#ifdef _WIN32
+    return "error " + std::to_string(GetLastError());
+#else
+    return std::strerror(errno);
+#endif
+}
+
+} // namespace
+
+std::string BinaryLogFormat::segmentPath(const std::string& base, uint32_t index) {
+    std::ostringstream name;
+    name << base << "_" << std::setw(4) << std::setfill('0') << index << ".binlog";
+    return name.str();
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+    close();
+}
+
+bool BinaryLogWriter::open(const std::string& basePath, std::chrono::nanoseconds wallClockOffset,
+                           std::string& error, size_t bytes) {
+    close();
+    base = basePath;
+    wallClockOffsetNs = wallClockOffset.count();
+    segmentBytes = bytes;
+    segmentIndex = 0;
+    return openSegment(error);
+}
+
+bool BinaryLogWriter::appendText(LogLevel level, std::chrono::steady_clock::time_point time,
+                                 std::string_view text, std::string& error) {
+    if (!reserve(BinaryLogFormat::recordSize(text.size()), error)) {
+        return false;
+    }
+    writeRecord(BinaryLogFormat::RecordKind::Text, level, time, nullptr, text);
+    return true;
+}
+
+bool BinaryLogWriter::appendFormatted(LogLevel level, std::chrono::steady_clock::time_point time,
+                                      std::string_view encoded, std::string& error) {
+    const std::string_view format = LogFormatting::formatOf(encoded);
+    if (format.data() == nullptr) {
+        return true; // Nothing to render; the ring never cuts a buffer this short.
+    }
+    const std::string_view arguments = encoded.substr(LogFormatting::kFormatHeaderBytes);
+    const size_t messageSize = BinaryLogFormat::recordSize(sizeof(uint32_t) + arguments.size());
+    const size_t formatSize = BinaryLogFormat::recordSize(sizeof(uint32_t) + format.size());
+
+    const bool known = formatIds.count(format.data()) != 0;
+    if (!reserve(known ? messageSize : messageSize + formatSize, error)) {
+        return false;
+    }
+    // Also taken when reserve() started a segment, which has no format strings yet.
+    auto found = formatIds.find(format.data());
+    if (found == formatIds.end()) {
+        if (used + messageSize + formatSize > segmentBytes) {
+            error = "Log record of " + std::to_string(messageSize + formatSize) +
+                    " bytes does not fit in a binary log segment";
+            return false;
+        }
+        found = formatIds.emplace(format.data(), static_cast<uint32_t>(formatIds.size())).first;
+        writeRecord(BinaryLogFormat::RecordKind::FormatString, LogLevel::Info, {}, &found->second, format);
+    }
+    writeRecord(BinaryLogFormat::RecordKind::Format, level, time, &found->second, arguments);
+    return true;
+}
+
+bool BinaryLogWriter::reserve(size_t size, std::string& error) {
+    if (!mapped) {
+        return false;
+    }
+    if (used + size <= segmentBytes) {
+        return true;
+    }
+    closeSegment();
+    ++segmentIndex;
+    if (!openSegment(error)) {
+        return false;
+    }
+    if (used + size > segmentBytes) {
+        error = "Log record of " + std::to_string(size) + " bytes does not fit in a binary log segment";
+        return false;
+    }
+    return true;
+}
+
+void BinaryLogWriter::writeRecord(BinaryLogFormat::RecordKind kind, LogLevel level,
+                                  std::chrono::steady_clock::time_point time, const uint32_t* id,
+                                  std::string_view data) {
+    const size_t payloadSize = (id ? sizeof(*id) : 0) + data.size();
+    const size_t size = BinaryLogFormat::recordSize(payloadSize);
+
+    BinaryLogFormat::RecordHeader header{};
+    header.size = static_cast<uint32_t>(size);
+    header.level = static_cast<uint8_t>(level);
+    header.kind = static_cast<uint8_t>(kind);
+    header.padding = static_cast<uint8_t>(size - sizeof(header) - payloadSize);
+    header.steadyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+
+    // The padding is already zero: the segment was created zero-filled.
+    char* out = mapped + used;
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    if (id) {
+        std::memcpy(out, id, sizeof(*id));
+        out += sizeof(*id);
+    }
+    std::memcpy(out, data.data(), data.size());
+    used += size;
+}
+
+void BinaryLogWriter::close() {
+    closeSegment();
+    path.clear();
+}
+
+bool BinaryLogWriter::openSegment(std::string& error) {
+    path = BinaryLogFormat::segmentPath(base, segmentIndex);
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+                                CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        error = "Failed to create binary log segment " + path + ": " + systemErrorText();
+        return false;
+    }
+    // Mapping a file larger than it is extends it, reserving the space.
+    const uint64_t size = segmentBytes;
+    HANDLE section = CreateFileMappingA(handle, NULL, PAGE_READWRITE, static_cast<DWORD>(size >> 32),
+                                        static_cast<DWORD>(size), NULL);
+    void* view = section ? MapViewOfFile(section, FILE_MAP_WRITE, 0, 0, segmentBytes) : nullptr;
+    if (!view) {
+        error = "Failed to map binary log segment " + path + ": " + systemErrorText();
+        if (section) {
+            CloseHandle(section);
+        }
+        CloseHandle(handle);
+        return false;
+    }
+    file = handle;
+    mapping = section;
+    mapped = static_cast<char*>(view);
+#else
+    const int segmentFd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (segmentFd == -1) {
+        error = "Failed to create binary log segment " + path + ": " + systemErrorText();
+        return false;
+    }
+    // posix_fallocate() returns the error instead of setting errno.
+    const int allocateResult = posix_fallocate(segmentFd, 0, static_cast<off_t>(segmentBytes));
+    if (allocateResult != 0) {
+        error = "Failed to reserve " + std::to_string(segmentBytes) + " bytes for binary log segment " +
+                path + ": " + std::strerror(allocateResult);
+        ::close(segmentFd);
+        return false;
+    }
+    void* view = mmap(nullptr, segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, segmentFd, 0);
+    if (view == MAP_FAILED) {
+        error = "Failed to map binary log segment " + path + ": " + systemErrorText();
+        ::close(segmentFd);
+        return false;
+    }
+    fd = segmentFd;
+    mapped = static_cast<char*>(view);
+#endif
+
+    BinaryLogFormat::SegmentHeader header{};
+    std::memcpy(header.magic, BinaryLogFormat::kMagic, sizeof(header.magic));
+    header.version = BinaryLogFormat::kVersion;
+    header.segmentIndex = segmentIndex;
+    header.wallClockOffsetNs = wallClockOffsetNs;
+    std::memcpy(mapped, &header, sizeof(header));
+    used = sizeof(header);
+    return true;
+}
+
+void BinaryLogWriter::closeSegment() {
+    if (!mapped) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(mapped);
+    CloseHandle(static_cast<HANDLE>(mapping));
+    LARGE_INTEGER end;
+    end.QuadPart = static_cast<LONGLONG>(used);
+    if (SetFilePointerEx(static_cast<HANDLE>(file), end, NULL, FILE_BEGIN)) {
+        SetEndOfFile(static_cast<HANDLE>(file));
+    }
+    CloseHandle(static_cast<HANDLE>(file));
+    file = nullptr;
+    mapping = nullptr;
+#else
+    munmap(mapped, segmentBytes);
+    // If this fails the file keeps its zero-filled tail, which readers stop at.
+    (void)ftruncate(fd, static_cast<off_t>(used));
+    ::close(fd);
+    fd = -1;
+#endif
+    mapped = nullptr;
+    used = 0;
+    formatIds.clear();
+}
+
+bool BinaryLogReader::open(const std::string& path, std::string& error) {
+    input.close();
+    input.clear();
+    input.open(path, std::ios::in | std::ios::binary);
+    if (!input.is_open()) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    if (!input.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, BinaryLogFormat::kMagic, sizeof(header.magic)) != 0) {
+        error = path + " is not a binary log segment";
+        return false;
+    }
+    if (header.version != BinaryLogFormat::kVersion) {
+        error = path + " has unsupported binary log version " + std::to_string(header.version);
+        return false;
+    }
+    formats.clear();
+    return true;
+}
+
+bool BinaryLogReader::next(Record& out) {
+    BinaryLogFormat::RecordHeader record;
+    while (input.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+        if (record.size < sizeof(record) + record.padding || record.size > kMaxRecordBytes) {
+            return false;
+        }
+        const size_t payloadBytes = record.size - sizeof(record) - record.padding;
+        payload.resize(payloadBytes);
+        if (!input.read(payload.data(), static_cast<std::streamsize>(payloadBytes)) ||
+            !input.ignore(record.padding)) {
+            return false;
+        }
+
+        const auto kind = static_cast<BinaryLogFormat::RecordKind>(record.kind);
+        uint32_t id = 0;
+        if (kind != BinaryLogFormat::RecordKind::Text) {
+            if (payload.size() < sizeof(id)) {
+                return false;
+            }
+            std::memcpy(&id, payload.data(), sizeof(id));
+        }
+        const std::string_view data = std::string_view(payload).substr(
+            kind == BinaryLogFormat::RecordKind::Text ? 0 : sizeof(id));
+
+        switch (kind) {
+        case BinaryLogFormat::RecordKind::FormatString:
+            // The writer numbers format strings in order, so any other id is corruption.
+            if (id > formats.size()) {
+                return false;
+            }
+            if (id == formats.size()) {
+                formats.emplace_back(data);
+            } else {
+                formats[id] = data;
+            }
+            continue;
+        case BinaryLogFormat::RecordKind::Format:
+            out.text = Logger::levelTag(static_cast<LogLevel>(record.level));
+            if (id < formats.size()) {
+                LogFormatting::renderArguments(out.text, formats[id], data);
+            } else {
+                out.text += "<unknown format " + std::to_string(id) + ">";
+            }
+            break;
+        case BinaryLogFormat::RecordKind::Text:
+            out.text = data;
+            break;
+        default:
+            continue; // A kind added by a later version.
+        }
+        out.level = static_cast<LogLevel>(record.level);
+        out.wallNs = record.steadyNs + header.wallClockOffsetNs;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "myiperf/Logger.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief On-disk layout of the binary log written with --log-format binary.
+ *
+ * A run writes one or more segment files, <name>_0000.binlog,
+ * <name>_0001.binlog, ... Each segment starts with a SegmentHeader and is
+ * followed by records, each a RecordHeader and a payload padded to
+ * kRecordAlignment. A record size of 0 ends the segment; segments left at
+ * full length by a crash end with zero-filled space, which reads the same.
+ *
+ * A MYIPERF_LOG_* statement is stored the way it travels through the log
+ * ring: the id of its format string and the encoded argument values. The
+ * format string itself is stored once per segment, in a FormatString record
+ * ahead of its first use, so every segment decodes on its own. Logger::log()
+ * messages are stored as text ("Info: ..." as in the text log, without the
+ * "[date time] " prefix).
+ *
+ * Record times are steady_clock nanoseconds. Adding the header's wall clock
+ * offset gives system_clock nanoseconds since the epoch, from which
+ * LogDecoder builds the timestamp of the text log.
+ */
+namespace BinaryLogFormat {
+
+constexpr char kMagic[8] = {'M', 'Y', 'I', 'P', 'B', 'L', 'O', 'G'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kRecordAlignment = 8;
+
+enum class RecordKind : uint8_t {
+    /**< Payload: the message text. */
+    Text,
+    /**< Payload: uint32_t format id, then the arguments as LogFormatting::encode() writes them. */
+    Format,
+    /**< Payload: uint32_t format id, then the format string. Level and time are unused. */
+    FormatString
+};
+
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    /**< Index of this segment within the run, from 0. */
+    uint32_t segmentIndex;
+    /**< system_clock minus steady_clock, in nanoseconds, when the run started. */
+    int64_t wallClockOffsetNs;
+    int64_t reserved[5];
+};
+static_assert(sizeof(SegmentHeader) == 64, "SegmentHeader is part of the file format");
+
+struct RecordHeader {
+    /**< Bytes of the whole record including this header and the padding; 0 ends the segment. */
+    uint32_t size;
+    uint8_t level;
+    uint8_t kind;
+    /**< Zero bytes after the payload that align the next record. */
+    uint8_t padding;
+    uint8_t reserved;
+    /**< steady_clock time of the log call in nanoseconds. */
+    int64_t steadyNs;
+};
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader is part of the file format");
+
+/** @brief Size of a record with a payload of payloadLength bytes. */
+constexpr size_t recordSize(size_t payloadLength) {
+    return (sizeof(RecordHeader) + payloadLength + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+/** @brief Segment file name: base + "_NNNN.binlog". */
+std::string segmentPath(const std::string& base, uint32_t index);
+
+} // namespace BinaryLogFormat
+
+/**
+ * @class BinaryLogWriter
+ * @brief Appends log records to memory-mapped, fixed-size segment files.
+ *
+ * A segment is created at its full size, mapped, and filled with memcpy, so
+ * appending a record costs no system call, no timestamp formatting and, for
+ * a formatted message, no rendering; the page cache writes the pages back.
+ * When a record does not fit, the segment is cut to the bytes used and the
+ * next one is created. The disk space of a segment is reserved up front, so a
+ * full disk shows up as a failed segment instead of a fault while copying.
+ *
+ * Used by the logger worker thread only.
+ */
+class BinaryLogWriter {
+public:
+    /** @brief Size of each segment file while it is being written. */
+    static constexpr size_t kDefaultSegmentBytes = 64 * 1024 * 1024;
+
+    BinaryLogWriter() = default;
+    ~BinaryLogWriter();
+    BinaryLogWriter(const BinaryLogWriter&) = delete;
+    BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+    /**
+     * @brief Creates the first segment, base + "_0000.binlog".
+     * @param wallClockOffset system_clock minus steady_clock, recorded in every segment.
+     * @param error Set to a description when the segment cannot be created.
+     */
+    bool open(const std::string& base, std::chrono::nanoseconds wallClockOffset,
+              std::string& error, size_t segmentBytes = kDefaultSegmentBytes);
+
+    /**
+     * @brief Appends a message text, starting a new segment when the current one is full.
+     * @param error Set when the record cannot be written. If a new segment
+     *        could not be created the writer is closed.
+     */
+    bool appendText(LogLevel level, std::chrono::steady_clock::time_point time,
+                    std::string_view text, std::string& error);
+
+    /**
+     * @brief Appends a buffer written by LogFormatting::encode() in this process,
+     *        as appendText() does.
+     */
+    bool appendFormatted(LogLevel level, std::chrono::steady_clock::time_point time,
+                         std::string_view encoded, std::string& error);
+
+    /** @brief Unmaps the current segment and cuts the file to the bytes written. */
+    void close();
+
+    bool isOpen() const { return mapped != nullptr; }
+    const std::string& currentPath() const { return path; }
+
+private:
+    bool openSegment(std::string& error);
+    void closeSegment();
+    /** Starts a new segment unless size more bytes fit in the current one. */
+    bool reserve(size_t size, std::string& error);
+    void writeRecord(BinaryLogFormat::RecordKind kind, LogLevel level,
+                     std::chrono::steady_clock::time_point time, const uint32_t* id,
+                     std::string_view data);
+
+    std::string base;
+    std::string path;
+    int64_t wallClockOffsetNs = 0;
+    size_t segmentBytes = kDefaultSegmentBytes;
+    uint32_t segmentIndex = 0;
+    char* mapped = nullptr;
+    size_t used = 0;
+    /**< Ids of the format strings already stored in the current segment, by address. */
+    std::unordered_map<const char*, uint32_t> formatIds;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+};
+
+/**
+ * @class BinaryLogReader
+ * @brief Reads the messages of one segment file in order, rendering
+ *        formatted messages into the text they have in the text log.
+ */
+class BinaryLogReader {
+public:
+    struct Record {
+        LogLevel level = LogLevel::Info;
+        /**< system_clock nanoseconds since the epoch. */
+        int64_t wallNs = 0;
+        std::string text;
+    };
+
+    /**
+     * @param error Set when the file cannot be read or is not a binary log.
+     */
+    bool open(const std::string& path, std::string& error);
+
+    /**
+     * @brief Reads the next message.
+     * @return False at the end of the segment, or at a record that is cut short.
+     */
+    bool next(Record& out);
+
+private:
+    std::ifstream input;
+    BinaryLogFormat::SegmentHeader header{};
+    /**< Format strings of this segment, by id. */
+    std::vector<std::string> formats;
+    std::string payload;
+};
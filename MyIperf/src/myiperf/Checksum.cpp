@@ -0,0 +1,238 @@
+#include "Checksum.h"
+
+#include "CpuFeatures.h"
+#include "myiperf/Protocol.h"
+
+#include <array>
+#include <cstring>
+
+#define XXH_INLINE_ALL
+#include "xxhash/xxhash.h"
+
+namespace Checksum {
+
+uint32_t sumScalar(const char* data, size_t size) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < size; ++i) {
+        sum += static_cast<unsigned char>(data[i]);
+    }
+    return sum;
+}
+
+namespace {
+
+// Reflected CRC-32C (Castagnoli) polynomial, as used by iSCSI, ext4 and the SSE4.2 CRC32 instruction.
+constexpr uint32_t kCrc32cPolynomial = 0x82F63B78u;
+
+constexpr std::array<uint32_t, 256> makeCrc32cTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1u) ? kCrc32cPolynomial : 0u);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> kCrc32cTable = makeCrc32cTable();
+
+} // namespace
+
+uint32_t crc32cSoftware(const char* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = kCrc32cTable[(crc ^ static_cast<unsigned char>(data[i])) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t xxh3Low32(const char* data, size_t size) {
+    return static_cast<uint32_t>(XXH3_64bits(data, size));
+}
+
+#ifdef MYIPERF_X86_64
+
+// The vector kernels use PSADBW against zero, which adds groups of 8 unsigned
+// bytes into 64-bit lanes. The lanes cannot overflow for any realistic buffer,
+// so truncating their total to 32 bits gives exactly the scalar wrap-around sum.
+
+namespace {
+
+MYIPERF_TARGET("sse2")
+uint64_t horizontalSum(__m128i lanes) {
+    alignas(16) uint64_t parts[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(parts), lanes);
+    return parts[0] + parts[1];
+}
+
+MYIPERF_TARGET("sse2")
+uint32_t sumSse2(const char* data, size_t size) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc0 = zero;
+    __m128i acc1 = zero;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16));
+        acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(a, zero));
+        acc1 = _mm_add_epi64(acc1, _mm_sad_epu8(b, zero));
+    }
+    if (i + 16 <= size) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(a, zero));
+        i += 16;
+    }
+    const uint64_t total = horizontalSum(_mm_add_epi64(acc0, acc1));
+    return static_cast<uint32_t>(total) + sumScalar(data + i, size - i);
+}
+
+MYIPERF_TARGET("avx2")
+uint32_t sumAvx2(const char* data, size_t size) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc0 = zero;
+    __m256i acc1 = zero;
+    __m256i acc2 = zero;
+    __m256i acc3 = zero;
+    size_t i = 0;
+    for (; i + 128 <= size; i += 128) {
+        const char* p = data + i;
+        acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), zero));
+        acc1 = _mm256_add_epi64(acc1, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32)), zero));
+        acc2 = _mm256_add_epi64(acc2, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 64)), zero));
+        acc3 = _mm256_add_epi64(acc3, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 96)), zero));
+    }
+    for (; i + 32 <= size; i += 32) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_sad_epu8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), zero));
+    }
+    const __m256i acc = _mm256_add_epi64(_mm256_add_epi64(acc0, acc1), _mm256_add_epi64(acc2, acc3));
+    const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    return static_cast<uint32_t>(horizontalSum(halves)) + sumScalar(data + i, size - i);
+}
+
+MYIPERF_TARGET("avx512f,avx512bw,bmi2")
+uint32_t sumAvx512(const char* data, size_t size) {
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i acc0 = zero;
+    __m512i acc1 = zero;
+    size_t i = 0;
+    for (; i + 128 <= size; i += 128) {
+        acc0 = _mm512_add_epi64(acc0, _mm512_sad_epu8(_mm512_loadu_si512(data + i), zero));
+        acc1 = _mm512_add_epi64(acc1, _mm512_sad_epu8(_mm512_loadu_si512(data + i + 64), zero));
+    }
+    if (i + 64 <= size) {
+        acc0 = _mm512_add_epi64(acc0, _mm512_sad_epu8(_mm512_loadu_si512(data + i), zero));
+        i += 64;
+    }
+    if (i < size) {
+        // Masked-off bytes read as zero and are never touched in memory, so the tail needs no scalar loop.
+        const __mmask64 mask = _bzhi_u64(~0ULL, static_cast<unsigned>(size - i));
+        acc1 = _mm512_add_epi64(acc1, _mm512_sad_epu8(_mm512_maskz_loadu_epi8(mask, data + i), zero));
+    }
+    // Zero-masked extracts: with GCC 12, _mm512_reduce_add_epi64,
+    // _mm512_castsi512_si256 and the unmasked extract trip -Wuninitialized
+    // inside avx512fintrin.h.
+    const __m512i acc = _mm512_add_epi64(acc0, acc1);
+    const __m256i quarters = _mm256_add_epi64(_mm512_maskz_extracti64x4_epi64(0xFF, acc, 0),
+                                              _mm512_maskz_extracti64x4_epi64(0xFF, acc, 1));
+    const __m128i halves = _mm_add_epi64(_mm256_castsi256_si128(quarters), _mm256_extracti128_si256(quarters, 1));
+    return static_cast<uint32_t>(horizontalSum(halves));
+}
+
+MYIPERF_TARGET("sse4.2")
+uint32_t crc32cSse42(const char* data, size_t size) {
+    uint64_t crc = 0xFFFFFFFFu;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        crc = _mm_crc32_u64(crc, word);
+    }
+    uint32_t crc32 = static_cast<uint32_t>(crc);
+    for (; i < size; ++i) {
+        crc32 = _mm_crc32_u8(crc32, static_cast<unsigned char>(data[i]));
+    }
+    return ~crc32;
+}
+
+} // namespace
+
+#endif // MYIPERF_X86_64
+
+std::vector<Kernel> supportedKernels() {
+    std::vector<Kernel> kernels{{"scalar", &sumScalar}};
+#ifdef MYIPERF_X86_64
+    const CpuFeatures& features = cpuFeatures();
+    if (features.sse2) {
+        kernels.push_back({"sse2", &sumSse2});
+    }
+    if (features.avx2) {
+        kernels.push_back({"avx2", &sumAvx2});
+    }
+    if (features.avx512bw) {
+        kernels.push_back({"avx512bw", &sumAvx512});
+    }
+#endif
+    return kernels;
+}
+
+const Kernel& selectedKernel() {
+    static const Kernel kernel = supportedKernels().back();
+    return kernel;
+}
+
+const Kernel& selectedCrc32cKernel() {
+    static const Kernel kernel = [] {
+#ifdef MYIPERF_X86_64
+        if (cpuFeatures().sse42) {
+            return Kernel{"sse4.2", &crc32cSse42};
+        }
+#endif
+        return Kernel{"table", &crc32cSoftware};
+    }();
+    return kernel;
+}
+
+} // namespace Checksum
+
+uint32_t calculateChecksum(const char* data, size_t size) {
+    static const Checksum::KernelFunction kernel = Checksum::selectedKernel().function;
+    return kernel(data, size);
+}
+
+uint32_t calculateIntegrity(IntegrityAlgorithm algorithm, const char* data, size_t size) {
+    switch (algorithm) {
+    case IntegrityAlgorithm::CRC32C: {
+        static const Checksum::KernelFunction kernel = Checksum::selectedCrc32cKernel().function;
+        return kernel(data, size);
+    }
+    case IntegrityAlgorithm::XXH3:
+        return Checksum::xxh3Low32(data, size);
+    case IntegrityAlgorithm::SUM:
+    default:
+        return calculateChecksum(data, size);
+    }
+}
+
+const char* integrityAlgorithmName(IntegrityAlgorithm algorithm) {
+    switch (algorithm) {
+    case IntegrityAlgorithm::CRC32C:
+        return "crc32c";
+    case IntegrityAlgorithm::XXH3:
+        return "xxh3";
+    case IntegrityAlgorithm::SUM:
+    default:
+        return "sum";
+    }
+}
+
+bool parseIntegrityAlgorithm(const std::string& name, IntegrityAlgorithm& algorithm) {
+    for (const auto candidate : {IntegrityAlgorithm::SUM, IntegrityAlgorithm::CRC32C, IntegrityAlgorithm::XXH3}) {
+        if (name == integrityAlgorithmName(candidate)) {
+            algorithm = candidate;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Kernels behind calculateChecksum() and calculateIntegrity().
+ *
+ * Every sum kernel computes the same value: the byte sum of the data modulo
+ * 2^32. Likewise both CRC-32C kernels agree bit for bit. The fastest kernel the
+ * CPU supports is picked once, on first use, and all later calls go straight
+ * to it. The individual kernels are exposed so the benchmark can compare them
+ * against their portable reference.
+ */
+namespace Checksum {
+
+using KernelFunction = uint32_t (*)(const char* data, size_t size);
+
+struct Kernel {
+    const char* name;
+    KernelFunction function;
+};
+
+/** @brief Byte-at-a-time reference implementation. */
+uint32_t sumScalar(const char* data, size_t size);
+
+/** @brief Table-driven CRC-32C reference implementation. */
+uint32_t crc32cSoftware(const char* data, size_t size);
+
+/** @brief Low 32 bits of XXH3-64 with seed 0. */
+uint32_t xxh3Low32(const char* data, size_t size);
+
+/** @brief Sum kernels this CPU can run, narrowest first; always starts with "scalar". */
+std::vector<Kernel> supportedKernels();
+
+/** @brief The kernel calculateChecksum() dispatches to. */
+const Kernel& selectedKernel();
+
+/** @brief The CRC-32C kernel calculateIntegrity() uses: "sse4.2" or "table". */
+const Kernel& selectedCrc32cKernel();
+
+} // namespace Checksum
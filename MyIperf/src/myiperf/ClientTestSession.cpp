@@ -30,6 +30,52 @@ void ClientTestSession::startReceiver() {
   throw std::runtime_error(message);
 }
 
+void ClientTestSession::applyConfirmedIntegrity(
+    const std::vector<char>& ackPayload) {
+  // Servers that predate integrity negotiation ack with an empty payload and
+  // verify data packets with the sum.
+  std::string confirmed = integrityAlgorithmName(IntegrityAlgorithm::SUM);
+  if (!ackPayload.empty()) {
+    const nlohmann::json ack = ControlProtocol::parseJsonPayload(ackPayload);
+    if (ack.contains("integrity")) {
+      confirmed = ack["integrity"].get<std::string>();
+    }
+  }
+
+  IntegrityAlgorithm integrity;
+  if (!parseIntegrityAlgorithm(confirmed, integrity)) {
+    fail("Error: Server confirmed unknown integrity algorithm '" + confirmed +
+         "'");
+  }
+  if (confirmed != context.config.getIntegrity()) {
+    Logger::log("Warning: Server does not support data integrity '" +
+                context.config.getIntegrity() + "'. Using '" + confirmed +
+                "'.");
+    context.config.setIntegrity(confirmed);
+  }
+  Logger::log("Info: Data integrity: " + confirmed);
+}
+
+void ClientTestSession::applyConfirmedOmit(const std::vector<char>& ackPayload) {
+  if (context.config.getOmitSeconds() <= 0.0) {
+    return;
+  }
+  // A server that does not confirm the window would count OMIT_END as an
+  // unknown message and keep the warm-up in its statistics.
+  double confirmed = 0.0;
+  if (!ackPayload.empty()) {
+    const nlohmann::json ack = ControlProtocol::parseJsonPayload(ackPayload);
+    if (ack.contains("omit")) {
+      confirmed = ack["omit"].get<double>();
+    }
+  }
+  if (confirmed != context.config.getOmitSeconds()) {
+    Logger::log("Warning: Server does not support --omit. Measuring from the "
+                "first packet.");
+    context.config.setOmitSeconds(0.0);
+  }
+}
+
 Task ClientTestSession::connectAndHandshake() {
   context.transitionTo(TestController::State::CONNECTING);
   if (!context.network.initialize("0.0.0.0", 0)) {
@@ -53,15 +99,32 @@ Task ClientTestSession::connectAndHandshake() {
   Logger::log("CONTROL: Sent CONFIG_HANDSHAKE.");
 
   context.transitionTo(TestController::State::WAITING_FOR_ACK);
-  co_await context.control.waitFor(MessageType::CONFIG_ACK,
-                                   context.config.getHandshakeTimeoutMs());
+  auto ackMessage = co_await context.control.waitFor(
+      MessageType::CONFIG_ACK, context.config.getHandshakeTimeoutMs());
   Logger::log("CONTROL: Received CONFIG_ACK.");
+  applyConfirmedIntegrity(ackMessage.payload);
+  applyConfirmedOmit(ackMessage.payload);
+
+  // The verification policy only thins out this side's own checks, so it
+  // needs no confirmation from the server.
+  const ReceiveChecks checks = ReceiveChecks::fromConfig(context.config);
+  context.receiver.configureChecks(checks);
+  Logger::log("Info: Payload verification: " +
+              describeVerification(context.config.getVerification(),
+                                   context.config.getVerificationSampleInterval()));
+
+  context.streams.create(context.config.getParallelStreams(),
+                         context.config.getNetworkBackend(), checks);
+  if (context.streams.extraStreamCount() > 0) {
+    co_await context.streams.connectAll(context.config.getTargetIP(),
+                                        context.config.getPort());
+  }
 }
 
 Task ClientTestSession::runClientToServerPhase() {
   context.transitionTo(TestController::State::RUNNING_TEST);
 
-  co_await context.generator.sendPackets(context.config);
+  co_await context.streams.sendPackets(context.generator, context.config);
   Logger::log("Info: Client generator finished.");
 
   context.transitionTo(TestController::State::FINISHING);
@@ -72,7 +135,8 @@ Task ClientTestSession::runClientToServerPhase() {
   co_await context.control.waitFor(MessageType::TEST_FIN);
   Logger::log("CONTROL: Received TEST_FIN from server for Phase 1.");
 
-  TestStats clientStats = context.generator.getStats();
+  TestStats clientStats =
+      context.streams.combineGeneratorStats(context.generator.getStats());
   context.generator.saveLastStats(clientStats);
   co_await context.control.send(MessageType::STATS_EXCHANGE,
                                 ControlProtocol::statsToPayload(clientStats));
@@ -94,17 +158,21 @@ Task ClientTestSession::runClientToServerPhase() {
 }
 
 Task ClientTestSession::runServerToClientPhase() {
+  context.streams.resetReceiverStats();
   co_await context.control.send(MessageType::CLIENT_READY);
   Logger::log("CONTROL: Sent CLIENT_READY for Phase 2.");
   context.transitionTo(TestController::State::WAITING_FOR_SERVER_FIN);
 
   context.receiver.resetStats();
 
-  co_await context.control.waitFor(MessageType::TEST_FIN);
+  co_await context.control.waitFor(
+      MessageType::TEST_FIN, ControlProtocol::dataPhaseTimeoutMs(context.config));
   Logger::log("CONTROL: Received TEST_FIN from server for Phase 2.");
+  co_await context.streams.waitForStreamFin();
 
   context.transitionTo(TestController::State::EXCHANGING_SERVER_STATS);
-  context.clientStatsPhase2 = context.receiver.getStats();
+  context.clientStatsPhase2 =
+      context.streams.combineReceiverStats(context.receiver.getStats());
 
   co_await context.control.send(
       MessageType::STATS_EXCHANGE,
@@ -3,6 +3,7 @@
 #include "TestSessionContext.h"
 
 #include <string>
+#include <vector>
 
 class ClientTestSession {
 public:
@@ -15,6 +16,8 @@ private:
 
   void startReceiver();
   [[noreturn]] void fail(const std::string& message);
+  void applyConfirmedIntegrity(const std::vector<char>& ackPayload);
+  void applyConfirmedOmit(const std::vector<char>& ackPayload);
 
   Task connectAndHandshake();
   Task runClientToServerPhase();
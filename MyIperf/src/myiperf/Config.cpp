@@ -1,4 +1,5 @@
 #include "myiperf/Config.h"
+#include "myiperf/Protocol.h"
 #include <stdexcept> // Required for std::invalid_argument
 
 /**
@@ -8,13 +9,32 @@
 Config::Config() : 
     packetSize(1024),      // Default packet size: 1024 bytes
     numPackets(0),         // 0 means unlimited until manually stopped
+    testDuration(0.0),     // 0 means no time limit
+    omitSeconds(0.0),      // 0 means every packet is measured
     sendIntervalMs(0),     // 0 means no delay between sends
     protocol("TCP"),       // Default protocol: TCP
     targetIP("127.0.0.1"), // Default IP: localhost
     port(5201),            // Default port: 5201
     mode(TestMode::CLIENT), // Default mode: Client
     saveLogs(false),       // Default saveLogs: false
-    handshakeTimeoutMs(5000) // Default handshake timeout: 5000 ms
+    logFlushMs(100),       // Default: write log lines at least every 100 ms
+#if defined(MYIPERF_ENABLE_DEBUG_LOGS) && MYIPERF_ENABLE_DEBUG_LOGS
+    logLevel("debug"),     // Debug builds show Debug: lines by default
+#else
+    logLevel("info"),      // Default: everything but Debug: lines
+#endif
+    logFormat("text"),     // Default: plain .log files
+    handshakeTimeoutMs(5000), // Default handshake timeout: 5000 ms
+    networkBackend("default"), // Default backend: platform default
+    parallelStreams(1),    // Default: a single data stream
+    zeroCopy(false),       // Default: regular copying sends
+    sendBatchSize(1),      // Default: one packet per send
+    integrity("sum"),      // Default: additive checksum, understood by every peer
+    verification("full"),  // Default: check every payload
+    verificationSampleInterval(64), // Default for "sampled": one packet in 64
+    bitrate(0),            // Default: no rate limit
+    pacingBusyWait(false), // Default: sleep on the backend timer for every gap
+    pacing("user")         // Default: pace in the generator
 {}
 
 /**
@@ -44,6 +64,38 @@ int Config::getNumPackets() const {
     return numPackets;
 }
 
+/**
+ * @brief Sets the sending time of each data phase.
+ * @param seconds The duration in seconds. 0 means no time limit.
+ * @throws std::invalid_argument if the duration is negative or longer than a day.
+ */
+void Config::setTestDuration(double seconds) {
+    if (!(seconds >= 0.0 && seconds <= 86400.0)) {
+        throw std::invalid_argument("Error: Test duration must be between 0 and 86400 seconds.");
+    }
+    testDuration = seconds;
+}
+
+double Config::getTestDuration() const {
+    return testDuration;
+}
+
+/**
+ * @brief Sets the warm-up window excluded from the statistics.
+ * @param seconds The window in seconds. 0 disables it.
+ * @throws std::invalid_argument if the window is negative or longer than a day.
+ */
+void Config::setOmitSeconds(double seconds) {
+    if (!(seconds >= 0.0 && seconds <= 86400.0)) {
+        throw std::invalid_argument("Error: Omit window must be between 0 and 86400 seconds.");
+    }
+    omitSeconds = seconds;
+}
+
+double Config::getOmitSeconds() const {
+    return omitSeconds;
+}
+
 void Config::setSendIntervalMs(int intervalMs) {
     if (intervalMs < 0) {
         throw std::invalid_argument("Error: sendIntervalMs must be >= 0.");
@@ -116,6 +168,39 @@ bool Config::getSaveLogs() const {
     return saveLogs;
 }
 
+void Config::setLogFlushMs(int intervalMs) {
+    if (intervalMs < 0 || intervalMs > 60000) {
+        throw std::invalid_argument("Error: Log flush interval must be between 0 and 60000 ms.");
+    }
+    logFlushMs = intervalMs;
+}
+
+int Config::getLogFlushMs() const {
+    return logFlushMs;
+}
+
+void Config::setLogLevel(const std::string& level) {
+    if (level != "error" && level != "warning" && level != "info" && level != "debug") {
+        throw std::invalid_argument("Error: Unsupported log level '" + level + "'. Use 'error', 'warning', 'info' or 'debug'.");
+    }
+    logLevel = level;
+}
+
+std::string Config::getLogLevel() const {
+    return logLevel;
+}
+
+void Config::setLogFormat(const std::string& format) {
+    if (format != "text" && format != "binary") {
+        throw std::invalid_argument("Error: Unsupported log format '" + format + "'. Use 'text' or 'binary'.");
+    }
+    logFormat = format;
+}
+
+std::string Config::getLogFormat() const {
+    return logFormat;
+}
+
 void Config::setHandshakeTimeoutMs(int timeoutMs) {
     if (timeoutMs <= 0) {
         throw std::invalid_argument("Error: handshakeTimeoutMs must be > 0.");
@@ -127,6 +212,132 @@ int Config::getHandshakeTimeoutMs() const {
     return handshakeTimeoutMs;
 }
 
+/**
+ * @brief Sets the network backend.
+ * @param backend The backend name ("default", "epoll" or "io_uring").
+ * @throws std::invalid_argument if the backend name is unknown.
+ */
+void Config::setNetworkBackend(const std::string& backend) {
+    if (backend != "default" && backend != "epoll" && backend != "io_uring") {
+        throw std::invalid_argument("Error: Unsupported network backend '" + backend + "'. Use 'default', 'epoll' or 'io_uring'.");
+    }
+    networkBackend = backend;
+}
+
+std::string Config::getNetworkBackend() const {
+    return networkBackend;
+}
+
+void Config::setParallelStreams(int streams) {
+    if (streams < 1 || streams > 128) {
+        throw std::invalid_argument("Error: parallelStreams must be between 1 and 128.");
+    }
+    parallelStreams = streams;
+}
+
+int Config::getParallelStreams() const {
+    return parallelStreams;
+}
+
+void Config::setZeroCopy(bool enabled) {
+    zeroCopy = enabled;
+}
+
+bool Config::getZeroCopy() const {
+    return zeroCopy;
+}
+
+void Config::setSendBatchSize(int packets) {
+    if (packets < 1 || packets > 1024) {
+        throw std::invalid_argument("Error: sendBatchSize must be between 1 and 1024.");
+    }
+    sendBatchSize = packets;
+}
+
+int Config::getSendBatchSize() const {
+    return sendBatchSize;
+}
+
+/**
+ * @brief Sets the data packet integrity algorithm.
+ * @param algorithm The algorithm name ("sum", "crc32c" or "xxh3").
+ * @throws std::invalid_argument if the algorithm name is unknown.
+ */
+void Config::setIntegrity(const std::string& algorithm) {
+    IntegrityAlgorithm parsed;
+    if (!parseIntegrityAlgorithm(algorithm, parsed)) {
+        throw std::invalid_argument("Error: Unsupported integrity algorithm '" + algorithm + "'. Use 'sum', 'crc32c' or 'xxh3'.");
+    }
+    integrity = algorithm;
+}
+
+std::string Config::getIntegrity() const {
+    return integrity;
+}
+
+/**
+ * @brief Sets the payload verification policy.
+ * @param policy The policy name ("full", "header-only" or "sampled").
+ * @throws std::invalid_argument if the policy name is unknown.
+ */
+void Config::setVerification(const std::string& policy) {
+    VerificationPolicy parsed;
+    if (!parseVerificationPolicy(policy, parsed)) {
+        throw std::invalid_argument("Error: Unsupported verification policy '" + policy + "'. Use 'full', 'header-only' or 'sampled'.");
+    }
+    verification = policy;
+}
+
+std::string Config::getVerification() const {
+    return verification;
+}
+
+void Config::setVerificationSampleInterval(int interval) {
+    if (interval < 1 || interval > 1000000) {
+        throw std::invalid_argument("Error: verificationSampleInterval must be between 1 and 1000000.");
+    }
+    verificationSampleInterval = interval;
+}
+
+int Config::getVerificationSampleInterval() const {
+    return verificationSampleInterval;
+}
+
+void Config::setBitrate(long long bitsPerSecond) {
+    if (bitsPerSecond < 0) {
+        throw std::invalid_argument("Error: bitrate must not be negative.");
+    }
+    bitrate = bitsPerSecond;
+}
+
+long long Config::getBitrate() const {
+    return bitrate;
+}
+
+void Config::setPacingBusyWait(bool enabled) {
+    pacingBusyWait = enabled;
+}
+
+bool Config::getPacingBusyWait() const {
+    return pacingBusyWait;
+}
+
+/**
+ * @brief Sets the pacing mechanism used with a bitrate.
+ * @param mechanism "user" or "kernel".
+ * @throws std::invalid_argument if the mechanism is unknown.
+ */
+void Config::setPacing(const std::string& mechanism) {
+    if (mechanism != "user" && mechanism != "kernel") {
+        throw std::invalid_argument("Error: Unsupported pacing '" + mechanism + "'. Use 'user' or 'kernel'.");
+    }
+    pacing = mechanism;
+}
+
+std::string Config::getPacing() const {
+    return pacing;
+}
+
 /**
  * @brief Converts the Config object to a JSON representation.
  * @return A nlohmann::json object.
@@ -135,6 +346,8 @@ nlohmann::json Config::toJson() const {
     nlohmann::json root;
     root["packetSize"] = packetSize;
     root["numPackets"] = numPackets;
+    root["testDuration"] = testDuration;
+    root["omit"] = omitSeconds;
     root["sendIntervalMs"] = sendIntervalMs;
     
     root["protocol"] = protocol;
@@ -142,7 +355,20 @@ nlohmann::json Config::toJson() const {
     root["port"] = port;
     root["mode"] = (mode == TestMode::CLIENT ? "CLIENT" : "SERVER");
     root["saveLogs"] = saveLogs;
+    root["logFlushMs"] = logFlushMs;
+    root["logLevel"] = logLevel;
+    root["logFormat"] = logFormat;
     root["handshakeTimeoutMs"] = handshakeTimeoutMs;
+    root["networkBackend"] = networkBackend;
+    root["parallelStreams"] = parallelStreams;
+    root["zeroCopy"] = zeroCopy;
+    root["sendBatchSize"] = sendBatchSize;
+    root["integrity"] = integrity;
+    root["verification"] = verification;
+    root["verificationSampleInterval"] = verificationSampleInterval;
+    root["bitrate"] = bitrate;
+    root["pacingBusyWait"] = pacingBusyWait;
+    root["pacing"] = pacing;
     return root;
 }
 
@@ -156,13 +382,28 @@ Config Config::fromJson(const nlohmann::json& json) {
     Config config;
     if (json.contains("packetSize")) config.setPacketSize(json["packetSize"].get<int>());
     if (json.contains("numPackets")) config.setNumPackets(json["numPackets"].get<int>());
+    if (json.contains("testDuration")) config.setTestDuration(json["testDuration"].get<double>());
+    if (json.contains("omit")) config.setOmitSeconds(json["omit"].get<double>());
     if (json.contains("sendIntervalMs")) config.setSendIntervalMs(json["sendIntervalMs"].get<int>());
     
     if (json.contains("protocol")) config.setProtocol(json["protocol"].get<std::string>());
     if (json.contains("targetIP")) config.setTargetIP(json["targetIP"].get<std::string>());
     if (json.contains("port")) config.setPort(json["port"].get<int>());
     if (json.contains("saveLogs")) config.setSaveLogs(json["saveLogs"].get<bool>());
+    if (json.contains("logFlushMs")) config.setLogFlushMs(json["logFlushMs"].get<int>());
+    if (json.contains("logLevel")) config.setLogLevel(json["logLevel"].get<std::string>());
+    if (json.contains("logFormat")) config.setLogFormat(json["logFormat"].get<std::string>());
     if (json.contains("handshakeTimeoutMs")) config.setHandshakeTimeoutMs(json["handshakeTimeoutMs"].get<int>());
+    if (json.contains("networkBackend")) config.setNetworkBackend(json["networkBackend"].get<std::string>());
+    if (json.contains("parallelStreams")) config.setParallelStreams(json["parallelStreams"].get<int>());
+    if (json.contains("zeroCopy")) config.setZeroCopy(json["zeroCopy"].get<bool>());
+    if (json.contains("sendBatchSize")) config.setSendBatchSize(json["sendBatchSize"].get<int>());
+    if (json.contains("integrity")) config.setIntegrity(json["integrity"].get<std::string>());
+    if (json.contains("verification")) config.setVerification(json["verification"].get<std::string>());
+    if (json.contains("verificationSampleInterval")) config.setVerificationSampleInterval(json["verificationSampleInterval"].get<int>());
+    if (json.contains("bitrate")) config.setBitrate(json["bitrate"].get<long long>());
+    if (json.contains("pacingBusyWait")) config.setPacingBusyWait(json["pacingBusyWait"].get<bool>());
+    if (json.contains("pacing")) config.setPacing(json["pacing"].get<std::string>());
     if (json.contains("mode")) {
         std::string modeStr = json["mode"].get<std::string>();
         if (modeStr == "CLIENT") {
@@ -12,13 +12,10 @@ ControlMessageBus::Awaiter::Awaiter(ControlMessageBus& bus,
     : bus(bus), type(type), timeoutMs(timeoutMs) {}
 
 ControlMessageBus::Awaiter::~Awaiter() {
-  cancelTimer = true;
-  if (timerThread.joinable()) {
-    if (timerThread.get_id() == std::this_thread::get_id()) {
-      timerThread.detach();
-    } else {
-      timerThread.join();
-    }
+  // cancel()은 실행 중인 timeout callback이 끝날 때까지 기다리므로,
+  // 이후에는 callback이 이 Awaiter를 만지지 않습니다.
+  if (timer != 0) {
+    TimerService::shared().cancel(timer);
   }
 }
 
@@ -34,45 +31,36 @@ bool ControlMessageBus::Awaiter::await_suspend(std::coroutine_handle<> h) {
   // 코루틴을 멈추는 직접 원인은 co_await이고, 여기서는 나중에
   // deliver(type)가 왔을 때 다시 깨울 continuation을 등록합니다.
   continuation = h;
+
+  std::lock_guard<std::mutex> lock(bus.mutex);
+  auto& queue = bus.bufferedMessages[type];
+  if (!queue.empty()) {
+    message = std::move(queue.front());
+    queue.pop();
+    return false;
+  }
+  bus.pendingWaits[type] = this;
+
   if (timeoutMs > 0) {
-    timerThread = std::thread([this, h]() {
-    const auto start = std::chrono::steady_clock::now();
-    while (!cancelTimer) {
-      const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-          std::chrono::steady_clock::now() - start);
-      if (elapsed.count() >= timeoutMs) {
-        std::coroutine_handle<> continuationToResume{nullptr};
-        {
-          std::lock_guard<std::mutex> lock(bus.mutex);
-          auto it = bus.pendingWaits.find(type);
-          if (it != bus.pendingWaits.end() && it->second == this) {
-            timedOut = true;
-            continuationToResume = h;
-            bus.pendingWaits.erase(it);
-          }
-        }
-        if (continuationToResume && !continuationToResume.done()) {
-          continuationToResume.resume();
+    // 등록과 같은 lock 안에서 예약하므로 timeout callback은 항상 등록된 뒤에
+    // pendingWaits를 봅니다. deliver()가 먼저 가져갔다면 아무 일도 하지 않습니다.
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    timer = TimerService::shared().schedule(deadline, [this, h]() {
+      {
+        std::lock_guard<std::mutex> lock(bus.mutex);
+        auto it = bus.pendingWaits.find(type);
+        if (it == bus.pendingWaits.end() || it->second != this) {
+          return;
         }
-        break;
+        timedOut = true;
+        bus.pendingWaits.erase(it);
+      }
+      if (!h.done()) {
+        h.resume();
       }
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
     });
   }
-
-  {
-    std::lock_guard<std::mutex> lock(bus.mutex);
-    auto& queue = bus.bufferedMessages[type];
-    if (!queue.empty()) {
-      message = std::move(queue.front());
-      queue.pop();
-      cancelTimer = true;
-      return false;
-    }
-    bus.pendingWaits[type] = this;
-  }
-
   return true;
 }
 
@@ -95,7 +83,7 @@ ControlMessageBus::Awaiter ControlMessageBus::waitFor(MessageType type,
 }
 
 void ControlMessageBus::deliver(const PacketHeader& header,
-                                const std::vector<char>& payload) {
+                                std::span<const char> payload) {
   if (header.messageType == MessageType::DATA_PACKET) {
     return;
   }
@@ -159,15 +147,16 @@ void ControlMessageBus::registerPendingWait(MessageType type,
 
 std::coroutine_handle<> ControlMessageBus::takeContinuationForMessage(
     const PacketHeader& header,
-    const std::vector<char>& payload) {
+    std::span<const char> payload) {
   std::lock_guard<std::mutex> lock(mutex);
   auto it = pendingWaits.find(header.messageType);
   if (it == pendingWaits.end() || !it->second) {
-    bufferedMessages[header.messageType].push({header, payload});
+    bufferedMessages[header.messageType].push(
+        {header, std::vector<char>(payload.begin(), payload.end())});
     return nullptr;
   }
 
-  it->second->message = {header, payload};
+  it->second->message = {header, std::vector<char>(payload.begin(), payload.end())};
   auto continuationToResume = it->second->continuation;
   pendingWaits.erase(it);
   return continuationToResume;
@@ -1,13 +1,14 @@
 #pragma once
 
 #include "myiperf/Protocol.h"
+#include "myiperf/TimerService.h"
 
 #include <atomic>
 #include <coroutine>
 #include <map>
 #include <mutex>
 #include <queue>
-#include <thread>
+#include <span>
 #include <vector>
 
 // ControlMessageBus는 "코루틴 대기 저장소"입니다.
@@ -24,6 +25,9 @@
 //
 // 즉 map이 코루틴을 멈추는 것은 아닙니다. co_await가 멈추고,
 // 이 클래스는 나중에 다시 깨울 continuation을 보관합니다.
+//
+// timeout은 wait마다 thread를 만들지 않고 공용 TimerService에 deadline을
+// 등록합니다. timeout이 나면 TimerService thread에서 코루틴이 재개됩니다.
 class ControlMessageBus {
 public:
   struct Message {
@@ -48,8 +52,7 @@ public:
     ControlMessageBus& bus;
     MessageType type;
     int timeoutMs;
-    std::thread timerThread;
-    std::atomic<bool> cancelTimer{false};
+    TimerService::TimerId timer = 0;
     std::coroutine_handle<> continuation{nullptr};
     Message message;
     bool timedOut = false;
@@ -57,7 +60,8 @@ public:
   };
 
   Awaiter waitFor(MessageType type, int timeoutMs = 5000);
-  void deliver(const PacketHeader& header, const std::vector<char>& payload);
+  // payload is copied; the caller's memory may be reused as soon as this returns.
+  void deliver(const PacketHeader& header, std::span<const char> payload);
   void clear();
   void cancelAll();
 
@@ -65,7 +69,7 @@ private:
   bool tryTakeBufferedMessage(MessageType type, Message& message);
   void registerPendingWait(MessageType type, Awaiter& awaiter);
   std::coroutine_handle<> takeContinuationForMessage(const PacketHeader& header,
-                                                     const std::vector<char>& payload);
+                                                     std::span<const char> payload);
 
   std::mutex mutex;
   std::map<MessageType, Awaiter*> pendingWaits;
@@ -2,6 +2,7 @@
 
 #include "myiperf/Logger.h"
 
+#include <cmath>
 #include <cstring>
 #include <iomanip>
 #include <sstream>
@@ -26,6 +27,8 @@ const char* messageTypeToString(MessageType type) {
     return "CLIENT_READY";
   case MessageType::SHUTDOWN_ACK:
     return "SHUTDOWN_ACK";
+  case MessageType::OMIT_END:
+    return "OMIT_END";
   default:
     return "UNKNOWN";
   }
@@ -57,9 +60,44 @@ std::string formatStatsForLogging(const TestStats& stats) {
      << "\n    - Sequence Errors:      " << stats.sequenceErrorCount
      << "\n    - Failed Checksums:     " << stats.failedChecksumCount
      << "\n    - Content Mismatches:   " << stats.contentMismatchCount;
+  if (!stats.verification.empty()) {
+    ss << " (verification: "
+       << describeVerification(stats.verification,
+                               stats.verificationSampleInterval)
+       << ", " << stats.payloadsVerified << " payloads checked)";
+  }
+  if (stats.sendOperations > 0) {
+    ss << "\n    - Packets per Send:     " << stats.packetsPerSend()
+       << " (" << stats.sendOperations << " sends)";
+  }
+  if (stats.omittedDuration > 0) {
+    ss << "\n    - Omitted (warm-up):    " << stats.omittedDuration << " s, "
+       << stats.omittedBytes << " bytes, " << stats.omittedThroughputMbps()
+       << " Mbps";
+  }
+  if (stats.targetBitrate > 0) {
+    ss << "\n    - Target Bitrate:       "
+       << static_cast<double>(stats.targetBitrate) / 1'000'000.0 << " Mbps ("
+       << std::showpos << stats.bitrateErrorPercent() << std::noshowpos
+       << "% achieved, " << stats.pacing << " pacing)";
+  }
   return ss.str();
 }
 
+void logStreamBreakdown(const TestStats& stats) {
+  for (size_t i = 0; i < stats.streams.size(); ++i) {
+    const TestStats& stream = stats.streams[i];
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "    [stream " << i << "] sent " << stream.totalPacketsSent
+       << " pkts / " << stream.totalBytesSent << " B, received "
+       << stream.totalPacketsReceived << " pkts / "
+       << stream.totalBytesReceived << " B, " << stream.throughputMbps
+       << " Mbps";
+    Logger::log(ss.str());
+  }
+}
+
 void logPhaseSummary(const std::string& title,
                      const std::string& firstLabel,
                      const TestStats& firstStats,
@@ -67,10 +105,19 @@ void logPhaseSummary(const std::string& title,
                      const TestStats& secondStats) {
   Logger::log("--- " + title + " ---");
   Logger::log(firstLabel + ":" + formatStatsForLogging(firstStats));
+  logStreamBreakdown(firstStats);
   Logger::log(secondLabel + ":" + formatStatsForLogging(secondStats));
+  logStreamBreakdown(secondStats);
   Logger::log("----------------------------");
 }
 
+int dataPhaseTimeoutMs(const Config& config) {
+  constexpr int kFinTimeoutMs = 5000;
+  return kFinTimeoutMs +
+         static_cast<int>(std::ceil(config.getOmitSeconds() * 1000.0)) +
+         static_cast<int>(std::ceil(config.getTestDuration() * 1000.0));
+}
+
 Task sendControlPacket(NetworkInterface& net,
                        MessageType type,
                        std::vector<char> payload) {
@@ -87,7 +134,7 @@ Task sendControlPacket(NetworkInterface& net,
                 payload.size());
   }
 
-  co_await net.send(packet);
+  co_await net.send(std::move(packet));
 }
 
 } // namespace ControlProtocol
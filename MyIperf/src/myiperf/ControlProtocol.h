@@ -1,5 +1,6 @@
 #pragma once
 
+#include "myiperf/Config.h"
 #include "myiperf/CoroutineSupport.h"
 #include "myiperf/NetworkInterface.h"
 #include "myiperf/Protocol.h"
@@ -16,12 +17,18 @@ TestStats parseStatsPayload(const std::vector<char>& payload);
 std::vector<char> statsToPayload(const TestStats& stats);
 
 std::string formatStatsForLogging(const TestStats& stats);
+void logStreamBreakdown(const TestStats& stats);
 void logPhaseSummary(const std::string& title,
                      const std::string& firstLabel,
                      const TestStats& firstStats,
                      const std::string& secondLabel,
                      const TestStats& secondStats);
 
+// How long a receiver waits for the sender's TEST_FIN: the usual 5 s plus the
+// --omit window, which the sender spends sending before any --time limit
+// starts counting, plus the whole --time duration.
+int dataPhaseTimeoutMs(const Config& config);
+
 Task sendControlPacket(NetworkInterface& net,
                        MessageType type,
                        std::vector<char> payload = {});
@@ -0,0 +1,48 @@
+#include "CpuFeatures.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace {
+
+CpuFeatures detectCpuFeatures() {
+    CpuFeatures features;
+#if defined(MYIPERF_X86_64) && defined(_MSC_VER)
+    int info[4] = {};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    features.sse2 = (info[3] & (1 << 26)) != 0;
+    features.sse42 = (info[2] & (1 << 20)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || maxLeaf < 7) {
+        return features;
+    }
+    // The OS must save the YMM (and for AVX-512, opmask/ZMM) state on context switch.
+    const unsigned long long xcr0 = _xgetbv(0);
+    const bool ymmState = (xcr0 & 0x6) == 0x6;
+    const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+    __cpuidex(info, 7, 0);
+    features.avx2 = ymmState && (info[1] & (1 << 5)) != 0;
+    features.avx512bw = zmmState && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0 &&
+                        (info[1] & (1 << 8)) != 0;
+#elif defined(MYIPERF_X86_64)
+    // libgcc/compiler-rt also check that the OS enabled the wider register state.
+    __builtin_cpu_init();
+    features.sse2 = __builtin_cpu_supports("sse2");
+    features.sse42 = __builtin_cpu_supports("sse4.2");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.avx512bw = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                        __builtin_cpu_supports("bmi2");
+#endif
+    return features;
+}
+
+} // namespace
+
+const CpuFeatures& cpuFeatures() {
+    static const CpuFeatures features = detectCpuFeatures();
+    return features;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+/**
+ * @brief Runtime CPU feature detection for the SIMD kernels.
+ *
+ * Kernels for an instruction set newer than the build's baseline are compiled
+ * with MYIPERF_TARGET("isa") and must only be called when cpuFeatures() reports
+ * that instruction set. Outside x86-64 no SIMD kernels are built and every flag
+ * is false.
+ */
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MYIPERF_X86_64 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+// MSVC allows any intrinsic in any function; the CPUID check alone guards the call.
+#define MYIPERF_TARGET(isa)
+#else
+#define MYIPERF_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+struct CpuFeatures {
+    bool sse2 = false;
+    bool sse42 = false;
+    bool avx2 = false;
+    /** AVX-512F and BW, plus BMI2 for building tail masks. */
+    bool avx512bw = false;
+};
+
+/** @brief Features of the running CPU, detected once on first use. */
+const CpuFeatures& cpuFeatures();
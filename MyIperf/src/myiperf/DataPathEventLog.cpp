@@ -0,0 +1,56 @@
+#include "DataPathEventLog.h"
+
+#include "myiperf/Logger.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+/**< Clock reads per interval at the previous interval's rate. */
+constexpr uint64_t kChecksPerInterval = 64;
+constexpr uint64_t kMaxCheckEvery = 4096;
+
+} // namespace
+
+DataPathEventLog::DataPathEventLog(std::string source, Clock::duration interval)
+    : source(std::move(source)), interval(interval) {}
+
+void DataPathEventLog::record(uint32_t first, uint32_t count, uint64_t size) {
+    if (!active) {
+        active = true;
+        intervalStart = Clock::now();
+        firstPacket = first;
+    }
+    ++calls;
+    packets += count;
+    bytes += size;
+    lastPacket = first + count - 1;
+
+    if (--recordsUntilCheck > 0) {
+        return;
+    }
+    const Clock::time_point now = Clock::now();
+    if (now - intervalStart >= interval) {
+        checkEvery = std::clamp<uint64_t>(calls / kChecksPerInterval, 1, kMaxCheckEvery);
+        flushAt(now);
+    }
+    recordsUntilCheck = checkEvery;
+}
+
+void DataPathEventLog::flush() {
+    if (active) {
+        flushAt(Clock::now());
+    }
+}
+
+void DataPathEventLog::flushAt(Clock::time_point now) {
+    MYIPERF_LOG_INFO("[data] {} packets={} bytes={} calls={} range={}-{} elapsed={:.3}s",
+                     source, packets, bytes, calls, firstPacket, lastPacket,
+                     std::chrono::duration<double>(now - intervalStart).count());
+
+    active = false;
+    calls = 0;
+    packets = 0;
+    bytes = 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class DataPathEventLog
+ * @brief Folds per-packet data path events into one log line per interval.
+ *
+ * Logging every packet costs a log record per packet, and a 10M packet run
+ * then writes 20M lines. record() only adds to counters; once per interval,
+ * and on flush(), a single structured line such as
+ *
+ *   Info: [data] PacketGenerator sent packets=81920 bytes=114688000 calls=10240 range=0-81919 elapsed=1.000s
+ *
+ * summarises the events since the previous line. The clock is not read on
+ * every record(): it is read about 64 times per interval at the rate of the
+ * previous interval, so at a steady rate a summary is at most 1/64 of an
+ * interval late, and slow streams still get a clock read per record.
+ *
+ * Not thread-safe; each instance belongs to one data path loop.
+ */
+class DataPathEventLog {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @param source Prefix of each line, e.g. "PacketGenerator sent".
+     * @param interval Minimum time between two summaries.
+     */
+    explicit DataPathEventLog(std::string source,
+                              Clock::duration interval = std::chrono::seconds(1));
+
+    /**
+     * @brief Counts packets carried by one call (a send or a receive).
+     * @param firstPacket Counter of the first packet of the call.
+     * @param packets Packets in the call; the last one is firstPacket + packets - 1.
+     * @param bytes Bytes in the call.
+     */
+    void record(uint32_t firstPacket, uint32_t packets, uint64_t bytes);
+
+    /** @brief Writes the pending summary, if any, and starts a new interval. */
+    void flush();
+
+private:
+    void flushAt(Clock::time_point now);
+
+    std::string source;
+    Clock::duration interval;
+    Clock::time_point intervalStart;
+    bool active = false;
+    uint64_t calls = 0;
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint32_t firstPacket = 0;
+    uint32_t lastPacket = 0;
+    /** Records until the next clock read. */
+    uint64_t recordsUntilCheck = 1;
+    uint64_t checkEvery = 1;
+};
@@ -0,0 +1,181 @@
+#include "DataStreamSet.h"
+
+#include "ControlProtocol.h"
+#include "NetworkInterfaceFactory.h"
+#include "myiperf/Logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+DataStreamSet::DataStreamSet() = default;
+
+DataStreamSet::~DataStreamSet() {
+  close();
+}
+
+void DataStreamSet::create(int streamCount, const std::string& backend,
+                           const ReceiveChecks& checks) {
+  close();
+  streams.clear();
+  for (int i = 1; i < streamCount; ++i) {
+    auto stream = std::make_unique<Stream>();
+    stream->network = createNetworkInterface(backend);
+    stream->messages = std::make_unique<ControlMessageBus>();
+    stream->generator = std::make_unique<PacketGenerator>(stream->network.get());
+    stream->receiver = std::make_unique<PacketReceiver>(stream->network.get());
+    stream->receiver->configureChecks(checks);
+    streams.push_back(std::move(stream));
+  }
+}
+
+size_t DataStreamSet::extraStreamCount() const {
+  return streams.size();
+}
+
+bool DataStreamSet::prepareServers(const std::string& ip, int basePort) {
+  for (size_t i = 0; i < streams.size(); ++i) {
+    const int port = basePort + static_cast<int>(i) + 1;
+    if (!streams[i]->network->prepareServer(ip, port)) {
+      MYIPERF_LOG_ERROR("Failed to prepare data stream {} on port {}", i + 1, port);
+      return false;
+    }
+  }
+  return true;
+}
+
+Task DataStreamSet::acceptAll() {
+  for (size_t i = 0; i < streams.size(); ++i) {
+    auto acceptResult = co_await streams[i]->network->accept();
+    if (!acceptResult.success) {
+      throw std::runtime_error("Error: Accept failed for data stream " +
+                               std::to_string(i + 1));
+    }
+    MYIPERF_LOG_INFO("Data stream {} connected from {}", i + 1, acceptResult.clientIP);
+    streams[i]->receiver->start(*streams[i]->messages);
+  }
+}
+
+Task DataStreamSet::connectAll(const std::string& ip, int basePort) {
+  for (size_t i = 0; i < streams.size(); ++i) {
+    const int port = basePort + static_cast<int>(i) + 1;
+    if (!streams[i]->network->initialize("0.0.0.0", 0)) {
+      throw std::runtime_error("Error: Client init failed for data stream " +
+                               std::to_string(i + 1));
+    }
+    bool connected = co_await streams[i]->network->connect(ip, port);
+    if (!connected) {
+      throw std::runtime_error("Error: Failed to connect data stream " +
+                               std::to_string(i + 1) + " to port " +
+                               std::to_string(port));
+    }
+    MYIPERF_LOG_INFO("Data stream {} connected.", i + 1);
+    streams[i]->receiver->start(*streams[i]->messages);
+  }
+}
+
+Task DataStreamSet::sendOnStream(Stream& stream, const Config& config) {
+  co_await stream.generator->sendPackets(config);
+  co_await ControlProtocol::sendControlPacket(*stream.network,
+                                              MessageType::TEST_FIN);
+}
+
+Task DataStreamSet::sendPackets(PacketGenerator& primary, const Config& config) {
+  std::vector<Task> tasks;
+  tasks.reserve(streams.size() + 1);
+  tasks.push_back(primary.sendPackets(config));
+  for (auto& stream : streams) {
+    tasks.push_back(sendOnStream(*stream, config));
+  }
+  co_await whenAll(std::move(tasks));
+}
+
+Task DataStreamSet::waitForStreamFin(int timeoutMs) {
+  for (size_t i = 0; i < streams.size(); ++i) {
+    co_await streams[i]->messages->waitFor(MessageType::TEST_FIN, timeoutMs);
+  }
+  if (!streams.empty()) {
+    Logger::log("CONTROL: Received TEST_FIN on all " +
+                std::to_string(streams.size()) + " extra data streams.");
+  }
+}
+
+void DataStreamSet::resetReceiverStats() {
+  for (auto& stream : streams) {
+    stream->receiver->resetStats();
+  }
+}
+
+TestStats DataStreamSet::combineGeneratorStats(const TestStats& primary) const {
+  if (streams.empty()) {
+    return primary;
+  }
+  std::vector<TestStats> perStream{primary};
+  for (const auto& stream : streams) {
+    perStream.push_back(stream->generator->getStats());
+  }
+  return aggregateStreamStats(std::move(perStream));
+}
+
+TestStats DataStreamSet::combineReceiverStats(const TestStats& primary) const {
+  if (streams.empty()) {
+    return primary;
+  }
+  std::vector<TestStats> perStream{primary};
+  for (const auto& stream : streams) {
+    perStream.push_back(stream->receiver->getStats());
+  }
+  return aggregateStreamStats(std::move(perStream));
+}
+
+NetworkIoStats DataStreamSet::ioStats() const {
+  NetworkIoStats total;
+  for (const auto& stream : streams) {
+    total += stream->network->getIoStats();
+  }
+  return total;
+}
+
+void DataStreamSet::close() {
+  for (auto& stream : streams) {
+    stream->generator->stop();
+    stream->receiver->stop();
+    stream->messages->cancelAll();
+    stream->network->close();
+  }
+}
+
+TestStats aggregateStreamStats(std::vector<TestStats> perStream) {
+  TestStats total;
+  for (const auto& stats : perStream) {
+    total.totalBytesSent += stats.totalBytesSent;
+    total.totalPacketsSent += stats.totalPacketsSent;
+    total.totalBytesReceived += stats.totalBytesReceived;
+    total.totalPacketsReceived += stats.totalPacketsReceived;
+    total.failedChecksumCount += stats.failedChecksumCount;
+    total.sequenceErrorCount += stats.sequenceErrorCount;
+    total.contentMismatchCount += stats.contentMismatchCount;
+    total.sendOperations += stats.sendOperations;
+    total.payloadsVerified += stats.payloadsVerified;
+    total.targetBitrate += stats.targetBitrate;
+    if (total.pacing.empty()) {
+      total.pacing = stats.pacing;
+    }
+    if (total.verification.empty()) {
+      total.verification = stats.verification;
+      total.verificationSampleInterval = stats.verificationSampleInterval;
+    }
+    total.omittedBytes += stats.omittedBytes;
+    total.omittedPackets += stats.omittedPackets;
+    total.omittedDuration = std::max(total.omittedDuration, stats.omittedDuration);
+    total.duration = std::max(total.duration, stats.duration);
+  }
+  if (total.duration > 0) {
+    const long long bytes = total.totalBytesReceived > 0
+                                ? total.totalBytesReceived
+                                : total.totalBytesSent;
+    total.throughputMbps =
+        (static_cast<double>(bytes) * 8.0) / total.duration / 1'000'000.0;
+  }
+  total.streams = std::move(perStream);
+  return total;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "ControlMessageBus.h"
+#include "PacketGenerator.h"
+#include "PacketReceiver.h"
+#include "myiperf/Config.h"
+#include "myiperf/CoroutineSupport.h"
+#include "myiperf/NetworkInterface.h"
+#include "myiperf/NetworkIoStats.h"
+#include "myiperf/Protocol.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class DataStreamSet
+ * @brief Owns the additional data connections of a parallel (-P N) test.
+ *
+ * Stream 0 is the primary connection owned by TestController; it carries both
+ * control messages and data. DataStreamSet owns streams 1..N-1, each with its
+ * own NetworkInterface, PacketGenerator and PacketReceiver, connected on
+ * port + i. Every extra stream also has a private ControlMessageBus so the
+ * per-stream TEST_FIN end marker cannot be confused with the primary one.
+ */
+class DataStreamSet {
+public:
+  DataStreamSet();
+  ~DataStreamSet();
+
+  /**
+   * @brief Replaces the current streams with streamCount - 1 new extra streams.
+   * @param streamCount Total number of data streams including the primary one.
+   * @param backend Network backend name passed to createNetworkInterface().
+   * @param checks Negotiated payload checks for the receivers.
+   */
+  void create(int streamCount, const std::string& backend,
+              const ReceiveChecks& checks);
+
+  /** @brief Number of extra streams (total streams minus the primary one). */
+  size_t extraStreamCount() const;
+
+  /**
+   * @brief Opens the listening sockets of the extra streams (server side).
+   * @return False if any stream failed to listen on basePort + i.
+   */
+  bool prepareServers(const std::string& ip, int basePort);
+
+  /** @brief Accepts one connection per extra stream and starts its receiver. */
+  Task acceptAll();
+
+  /** @brief Connects every extra stream to basePort + i and starts its receiver. */
+  Task connectAll(const std::string& ip, int basePort);
+
+  /**
+   * @brief Runs the primary generator and all extra generators concurrently.
+   *
+   * Each extra stream sends TEST_FIN on its own connection after its last data
+   * packet. The primary TEST_FIN remains the session's responsibility.
+   */
+  Task sendPackets(PacketGenerator& primary, const Config& config);
+
+  /** @brief Waits until every extra stream has delivered its TEST_FIN marker. */
+  Task waitForStreamFin(int timeoutMs = 5000);
+
+  /** @brief Resets the receive counters of all extra streams. */
+  void resetReceiverStats();
+
+  /**
+   * @brief Combines primary and extra generator stats.
+   * @return primary unchanged for single-stream tests, otherwise the aggregate
+   *         with the per-stream breakdown in TestStats::streams.
+   */
+  TestStats combineGeneratorStats(const TestStats& primary) const;
+
+  /** @brief Same as combineGeneratorStats() for the receivers. */
+  TestStats combineReceiverStats(const TestStats& primary) const;
+
+  /** @brief Sums the syscall counters of the extra streams' interfaces. */
+  NetworkIoStats ioStats() const;
+
+  /** @brief Stops generators and receivers and closes all extra connections. */
+  void close();
+
+private:
+  struct Stream {
+    std::unique_ptr<NetworkInterface> network;
+    std::unique_ptr<ControlMessageBus> messages;
+    std::unique_ptr<PacketGenerator> generator;
+    std::unique_ptr<PacketReceiver> receiver;
+  };
+
+  Task sendOnStream(Stream& stream, const Config& config);
+
+  std::vector<std::unique_ptr<Stream>> streams;
+};
+
+/**
+ * @brief Aggregates per-stream stats into one TestStats.
+ *
+ * Counters are summed, the duration is the longest stream duration and the
+ * throughput is recomputed from the summed bytes over that duration.
+ * The input is kept in TestStats::streams.
+ */
+TestStats aggregateStreamStats(std::vector<TestStats> perStream);
@@ -0,0 +1,152 @@
+#include "myiperf/LogFormat.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace LogFormatting {
+
+namespace {
+
+/**< Reads encoded values front to back; every read fails once the bytes run out. */
+class Reader {
+public:
+    explicit Reader(std::string_view bytes) : bytes(bytes) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (bytes.size() < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, bytes.data(), sizeof(T));
+        bytes.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    bool readString(std::string_view& value, uint32_t length) {
+        if (bytes.size() < length) {
+            return false;
+        }
+        value = bytes.substr(0, length);
+        bytes.remove_prefix(length);
+        return true;
+    }
+
+private:
+    std::string_view bytes;
+};
+
+template <typename T>
+void appendNumber(std::string& out, T value) {
+    char digits[32];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+void appendFixed(std::string& out, double value, int precision) {
+    char digits[512];
+    const auto result = std::to_chars(digits, digits + sizeof(digits), value,
+                                      std::chars_format::fixed, precision);
+    if (result.ec == std::errc()) {
+        out.append(digits, result.ptr);
+    } else {
+        appendNumber(out, value); // Too wide for fixed notation.
+    }
+}
+
+/**
+ * @return False if the buffer ended before the argument.
+ */
+bool appendArg(std::string& out, Reader& reader, int precision) {
+    uint8_t kind;
+    if (!reader.read(kind)) {
+        return false;
+    }
+    switch (static_cast<ArgKind>(kind)) {
+    case ArgKind::Signed: {
+        int64_t value;
+        if (!reader.read(value)) return false;
+        appendNumber(out, value);
+        return true;
+    }
+    case ArgKind::Unsigned: {
+        uint64_t value;
+        if (!reader.read(value)) return false;
+        appendNumber(out, value);
+        return true;
+    }
+    case ArgKind::Floating: {
+        double value;
+        if (!reader.read(value)) return false;
+        appendFixed(out, value, precision >= 0 ? precision : kDefaultPrecision);
+        return true;
+    }
+    case ArgKind::Boolean: {
+        char value;
+        if (!reader.read(value)) return false;
+        out += value ? "true" : "false";
+        return true;
+    }
+    case ArgKind::Character: {
+        char value;
+        if (!reader.read(value)) return false;
+        out += value;
+        return true;
+    }
+    case ArgKind::String: {
+        uint32_t length;
+        std::string_view value;
+        if (!reader.read(length) || !reader.readString(value, length)) return false;
+        out += value;
+        return true;
+    }
+    }
+    return false;
+}
+
+} // namespace
+
+void render(std::string& out, std::string_view encoded) {
+    if (encoded.size() < kFormatHeaderBytes) {
+        return;
+    }
+    renderArguments(out, formatOf(encoded), encoded.substr(kFormatHeaderBytes));
+}
+
+std::string_view formatOf(std::string_view encoded) {
+    Reader reader(encoded);
+    const char* formatData;
+    uint32_t formatSize;
+    if (!reader.read(formatData) || !reader.read(formatSize)) {
+        return {};
+    }
+    return std::string_view(formatData, formatSize);
+}
+
+void renderArguments(std::string& out, std::string_view format, std::string_view arguments) {
+    Reader reader(arguments);
+    size_t literalStart = 0;
+    for (size_t i = 0; i < format.size(); ++i) {
+        const char c = format[i];
+        if (c != '{' && c != '}') {
+            continue;
+        }
+        out.append(format.data() + literalStart, i - literalStart);
+        if (i + 1 < format.size() && format[i + 1] == c) {
+            // "{{" or "}}": keep one brace.
+            out += c;
+            ++i;
+        } else {
+            int precision = -1;
+            const size_t close = parsePlaceholder(format, i, precision);
+            if (close == std::string_view::npos || !appendArg(out, reader, precision)) {
+                out += "...";
+                return;
+            }
+            i = close;
+        }
+        literalStart = i + 1;
+    }
+    out.append(format.data() + literalStart, format.size() - literalStart);
+}
+
+} // namespace LogFormatting
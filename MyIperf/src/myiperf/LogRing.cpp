@@ -0,0 +1,155 @@
+#include "LogRing.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/**< Header at the start of a record's first slot. */
+struct RecordHeader {
+    int64_t ticks;
+    uint32_t length;
+    uint16_t slotCount;
+    uint8_t level;
+    uint8_t encoding;
+};
+
+constexpr size_t kSlotPayload = LogRing::kSlotSize - sizeof(std::atomic<uint64_t>);
+constexpr size_t kFirstSlotPayload = kSlotPayload - sizeof(RecordHeader);
+
+size_t slotsFor(size_t length) {
+    if (length <= kFirstSlotPayload) {
+        return 1;
+    }
+    return 1 + (length - kFirstSlotPayload + kSlotPayload - 1) / kSlotPayload;
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+LogRing::LogRing(size_t slotCount) {
+    // The largest record must fit, otherwise it could never be pushed.
+    const size_t capacity = roundUpToPowerOfTwo(std::max(slotCount, slotsFor(kMaxMessageBytes)));
+    slots = std::make_unique<Slot[]>(capacity);
+    mask = capacity - 1;
+    for (size_t i = 0; i < capacity; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+LogRing::~LogRing() = default;
+
+bool LogRing::push(LogLevel level, Encoding encoding, Clock::time_point time, std::string_view payload) {
+    const size_t length = std::min(payload.size(), kMaxMessageBytes);
+    const size_t count = slotsFor(length);
+
+    // Slots are released in order, so the claim is free once its last slot is.
+    uint64_t pos = head.load(std::memory_order_relaxed);
+    while (true) {
+        const uint64_t last = pos + count - 1;
+        const uint64_t sequence = slots[last & mask].sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(last);
+        if (diff == 0) {
+            if (head.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    RecordHeader header{};
+    header.ticks = time.time_since_epoch().count();
+    header.length = static_cast<uint32_t>(length);
+    header.slotCount = static_cast<uint16_t>(count);
+    header.level = static_cast<uint8_t>(level);
+    header.encoding = static_cast<uint8_t>(encoding);
+
+    Slot& first = slots[pos & mask];
+    std::memcpy(first.bytes, &header, sizeof(header));
+    size_t copied = std::min(length, kFirstSlotPayload);
+    std::memcpy(first.bytes + sizeof(header), payload.data(), copied);
+    for (size_t i = 1; i < count; ++i) {
+        const size_t chunk = std::min(length - copied, kSlotPayload);
+        std::memcpy(slots[(pos + i) & mask].bytes, payload.data() + copied, chunk);
+        copied += chunk;
+    }
+    // Publishing the first slot makes the continuation slots visible too.
+    first.sequence.store(pos + 1, std::memory_order_release);
+
+    // Pairs with the fence in waitForRecords(): either the consumer sees the
+    // record before sleeping, or this thread sees it waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumerWaiting.load(std::memory_order_relaxed)) {
+        wakeup.notify_one();
+    }
+    return true;
+}
+
+bool LogRing::hasRecord() const {
+    return slots[tail & mask].sequence.load(std::memory_order_acquire) == tail + 1;
+}
+
+bool LogRing::pop(Record& out) {
+    if (!hasRecord()) {
+        return false;
+    }
+    Slot& first = slots[tail & mask];
+    RecordHeader header;
+    std::memcpy(&header, first.bytes, sizeof(header));
+    out.time = Clock::time_point(Clock::duration(header.ticks));
+    out.level = static_cast<LogLevel>(header.level);
+    out.encoding = static_cast<Encoding>(header.encoding);
+
+    size_t copied = std::min<size_t>(header.length, kFirstSlotPayload);
+    out.payload.assign(first.bytes + sizeof(header), copied);
+    for (size_t i = 1; i < header.slotCount; ++i) {
+        const size_t chunk = std::min<size_t>(header.length - copied, kSlotPayload);
+        out.payload.append(slots[(tail + i) & mask].bytes, chunk);
+        copied += chunk;
+    }
+
+    const uint64_t capacity = mask + 1;
+    for (size_t i = 0; i < header.slotCount; ++i) {
+        slots[(tail + i) & mask].sequence.store(tail + i + capacity, std::memory_order_release);
+    }
+    tail += header.slotCount;
+    return true;
+}
+
+void LogRing::waitForRecords(Clock::duration timeout) {
+    std::unique_lock<std::mutex> lock(waitMutex);
+    consumerWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!hasRecord()) {
+        wakeup.wait_for(lock, timeout);
+    }
+    consumerWaiting.store(false, std::memory_order_relaxed);
+}
+
+void LogRing::wake() {
+    {
+        std::lock_guard<std::mutex> lock(waitMutex);
+    }
+    wakeup.notify_one();
+}
+
+void LogRing::clear() {
+    Record discarded;
+    while (pop(discarded)) {
+    }
+}
+
+uint64_t LogRing::dropped() const {
+    return droppedCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "myiperf/Logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+/**
+ * @class LogRing
+ * @brief Bounded lock-free multi-producer, single-consumer queue of log records.
+ *
+ * The ring is an array of fixed-size slots, each with a sequence number
+ * (a Vyukov bounded queue). A record is a header holding the steady_clock
+ * ticks at which it was logged, its level, its encoding and the payload
+ * length, followed by the payload bytes: the message text, or a format
+ * string and its arguments as written by LogFormatting::encode(). A long
+ * payload spans several consecutive slots.
+ *
+ * A producer claims its slots with one compare-and-swap on the head, copies
+ * the record in and publishes it by advancing the first slot's sequence. It
+ * never takes a lock and never waits: if the slots are still occupied the
+ * record is dropped and counted instead.
+ *
+ * The consumer (the logger worker) pops records in order and releases their
+ * slots. It sleeps in waitForRecords(); a producer only touches the condition
+ * variable when the consumer has announced that it is about to sleep, so a
+ * busy logger costs no notification per record. A wake-up that races the
+ * consumer falling asleep is picked up when the wait times out.
+ */
+class LogRing {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief How a record's payload is to be turned into text. */
+    enum class Encoding : uint8_t {
+        Text,
+        Format
+    };
+
+    /** @brief A popped record; payload keeps its capacity between pops. */
+    struct Record {
+        Clock::time_point time;
+        LogLevel level = LogLevel::Info;
+        Encoding encoding = Encoding::Text;
+        std::string payload;
+    };
+
+    /** @brief Size of one slot including its sequence number. */
+    static constexpr size_t kSlotSize = 128;
+    /** @brief Longest payload kept; longer payloads are truncated. */
+    static constexpr size_t kMaxMessageBytes = 8 * 1024;
+
+    /**
+     * @param slotCount Number of slots; rounded up to a power of two.
+     */
+    explicit LogRing(size_t slotCount);
+    ~LogRing();
+    LogRing(const LogRing&) = delete;
+    LogRing& operator=(const LogRing&) = delete;
+
+    /**
+     * @brief Appends a record. Safe to call from any thread.
+     * @return False if the ring was full and the record was dropped.
+     */
+    bool push(LogLevel level, Encoding encoding, Clock::time_point time, std::string_view payload);
+
+    /**
+     * @brief Removes the oldest published record. Consumer only.
+     * @return False if there is none.
+     */
+    bool pop(Record& out);
+
+    /**
+     * @brief Sleeps until a record may be available or timeout passes. Consumer only.
+     */
+    void waitForRecords(Clock::duration timeout);
+
+    /** @brief Wakes the consumer, e.g. to let it see a stop request. */
+    void wake();
+
+    /**
+     * @brief Discards all published records. Consumer only, or when there is no consumer.
+     */
+    void clear();
+
+    /** @brief Number of records dropped because the ring was full. */
+    uint64_t dropped() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence;
+        char bytes[kSlotSize - sizeof(std::atomic<uint64_t>)];
+    };
+
+    /** True if the consumer's next slot holds a published record. */
+    bool hasRecord() const;
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    alignas(64) std::atomic<uint64_t> head{0};
+    /** Next position to pop; only the consumer touches it. */
+    alignas(64) uint64_t tail = 0;
+    std::atomic<uint64_t> droppedCount{0};
+
+    std::atomic<bool> consumerWaiting{false};
+    std::mutex waitMutex;
+    std::condition_variable wakeup;
+};
@@ -1,5 +1,7 @@
 #include "myiperf/Logger.h"
 #include "myiperf/Version.h"
+#include "BinaryLog.h"
+#include "LogRing.h"
 #include <chrono>
 #include <ctime>
 #include <iomanip>
@@ -7,6 +9,8 @@
 #include <vector>
 #include <algorithm>
 #include <filesystem>
+#include <cstdlib>
+#include <string_view>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -15,18 +19,23 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <fcntl.h>
+#include <signal.h>
+#include <pthread.h>
+#include <cerrno>
+#include <climits>
 #endif
 
 // Initialize static member variables.
-std::mutex Logger::queueMutex;
-std::condition_variable Logger::cv;
-std::deque<std::string> Logger::messageQueue;
+// 4096 slots of 128 bytes: 512KB, a few thousand typical lines of backlog.
+LogRing Logger::ring(4096);
 std::thread Logger::workerThread;
 std::mutex Logger::startStopMutex;
 std::atomic<bool> Logger::started(false);
 std::atomic<bool> Logger::running(false);
+std::atomic<uint8_t> Logger::maxLevel(static_cast<uint8_t>(LogLevel::Info));
 std::mutex Logger::immediateMutex;
 std::ofstream Logger::logStream;
+BinaryLogWriter Logger::binaryLog;
 std::atomic<bool> Logger::saveToFile(false);
 const std::string Logger::logDirectory = "Log";
 
@@ -35,21 +44,60 @@ std::atomic<bool> Logger::pipeConnected(false);
 std::thread Logger::pipeThread;
 #ifdef _WIN32
 void* Logger::hPipe = INVALID_HANDLE_VALUE;
+#else
+int Logger::pipeFd = -1;
+std::string Logger::pipeCarry;
+std::chrono::steady_clock::time_point Logger::nextPipeOpen;
 #endif
+std::chrono::milliseconds Logger::flushInterval(100);
 
 // 정적 멤버 변수 초기화 (기본값: true)
 bool Logger::consoleOutput = true;
 
 namespace {
 
-#if defined(MYIPERF_ENABLE_DEBUG_LOGS) && MYIPERF_ENABLE_DEBUG_LOGS
-constexpr bool kDebugLogsEnabled = true;
-#else
-constexpr bool kDebugLogsEnabled = false;
+/**< How long the idle worker sleeps before checking the ring on its own. */
+constexpr auto kWorkerIdleWait = std::chrono::milliseconds(100);
+/**< Minimum time between two drop warnings while the ring keeps overflowing. */
+constexpr auto kDropReportInterval = std::chrono::seconds(1);
+/**< A batch this large is written without waiting for the flush interval. */
+constexpr size_t kMaxBatchBytes = 256 * 1024;
+#ifndef _WIN32
+/**< How often the worker retries opening the FIFO while no reader is attached. */
+constexpr auto kPipeReopenInterval = std::chrono::seconds(1);
+
+/**
+ * @brief Writes data to a non-blocking fd until all of it is written or the fd is full.
+ * @return Bytes written, or -1 on an error other than EAGAIN, with errno set.
+ */
+ssize_t writeAvailable(int fd, std::string_view data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        const ssize_t result = ::write(fd, data.data() + written, data.size() - written);
+        if (result > 0) {
+            written += static_cast<size_t>(result);
+        } else if (result == 0 || errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            return -1;
+        }
+    }
+    return static_cast<ssize_t>(written);
+}
 #endif
 
-bool isDebugLine(const std::string& message) {
-    return message.rfind("Debug:", 0) == 0;
+LogLevel parseLogLevel(const std::string& name) {
+    if (name == "error") return LogLevel::Error;
+    if (name == "warning") return LogLevel::Warning;
+    if (name == "debug") return LogLevel::Debug;
+    return LogLevel::Info;
+}
+
+LogLevel levelOf(const std::string& message) {
+    if (message.rfind("Error:", 0) == 0) return LogLevel::Error;
+    if (message.rfind("Warning:", 0) == 0) return LogLevel::Warning;
+    if (message.rfind("Debug:", 0) == 0) return LogLevel::Debug;
+    return LogLevel::Info;
 }
 
 std::string buildTimestampedLine(const std::string& message) {
@@ -61,14 +109,65 @@ std::string buildTimestampedLine(const std::string& message) {
     return oss.str();
 }
 
+/**
+ * @brief system_clock minus steady_clock, turning record times into wall clock times.
+ */
+std::chrono::nanoseconds wallClockOffset() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch() - LogRing::Clock::now().time_since_epoch());
+}
+
+/**
+ * @brief Turns steady_clock record times into "[YYYY-mm-dd HH:MM:SS] " prefixes.
+ *
+ * The wall clock offset is taken once, and the prefix is rebuilt only when
+ * the second changes, so formatting a burst of records costs no localtime or
+ * put_time call per record.
+ */
+class TimestampFormatter {
+public:
+    TimestampFormatter()
+        : wallOffset(std::chrono::duration_cast<std::chrono::system_clock::duration>(wallClockOffset())) {}
+
+    const std::string& prefix(LogRing::Clock::time_point time) {
+        const std::chrono::system_clock::time_point wall(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(time.time_since_epoch()) +
+            wallOffset);
+        const std::time_t seconds = std::chrono::system_clock::to_time_t(wall);
+        if (seconds != cachedSecond) {
+            cachedSecond = seconds;
+            std::tm local_tm = *std::localtime(&seconds);
+            std::ostringstream oss;
+            oss << "[" << std::put_time(&local_tm, "%Y-%m-%d %H:%M:%S") << "] ";
+            cachedPrefix = oss.str();
+        }
+        return cachedPrefix;
+    }
+
+private:
+    std::chrono::system_clock::duration wallOffset;
+    std::time_t cachedSecond = -1;
+    std::string cachedPrefix;
+};
+
+constexpr const char* kColorReset = "\x1b[0m";
+
+/**
+ * @brief Console colour escape for a message, or nullptr for the default colour.
+ */
+const char* colorOf(const std::string& message) {
+    if (message.rfind("Error:", 0) == 0) return "\x1b[31m";
+    if (message.rfind("Warning:", 0) == 0) return "\x1b[33m";
+    if (message.rfind("Info:", 0) == 0) return "\x1b[32m";
+    if (message.rfind("Debug:", 0) == 0) return "\x1b[36m";
+    if (message.rfind("CONTROL:", 0) == 0) return "\x1b[95m";
+    if (message.rfind("HANDSHAKE:", 0) == 0) return "\x1b[95m";
+    return nullptr;
+}
+
 std::string colorizeLine(const std::string& message, const std::string& formatted) {
-    if (message.rfind("Error:", 0) == 0) return std::string("\x1b[31m") + formatted + "\x1b[0m";
-    if (message.rfind("Warning:", 0) == 0) return std::string("\x1b[33m") + formatted + "\x1b[0m";
-    if (message.rfind("Info:", 0) == 0) return std::string("\x1b[32m") + formatted + "\x1b[0m";
-    if (message.rfind("Debug:", 0) == 0) return std::string("\x1b[36m") + formatted + "\x1b[0m";
-    if (message.rfind("CONTROL:", 0) == 0) return std::string("\x1b[95m") + formatted + "\x1b[0m";
-    if (message.rfind("HANDSHAKE:", 0) == 0) return std::string("\x1b[95m") + formatted + "\x1b[0m";
-    return formatted;
+    const char* color = colorOf(message);
+    return color ? color + formatted + kColorReset : formatted;
 }
 
 std::string buildInfoOneLine() {
@@ -100,7 +199,8 @@ void Logger::manageLogRotation(const std::string& mode) {
     std::string mode_str = "_" + mode + "_";
 
     for (const auto& entry : std::filesystem::directory_iterator(logDirectory)) {
-        if (entry.is_regular_file() && entry.path().extension() == ".log") {
+        if (entry.is_regular_file() &&
+            (entry.path().extension() == ".log" || entry.path().extension() == ".binlog")) {
             if (entry.path().string().find(mode_str) != std::string::npos) {
                 logFiles.push_back(entry.path());
             }
@@ -131,6 +231,7 @@ void Logger::start(const Config& config) {
     const std::string mode = config.getMode() == Config::TestMode::CLIENT ? "CLIENT" : "SERVER";
     std::string timestampLabel;
     std::string logOpenError;
+    std::string binaryLogPath;
     bool alreadyStarted = false;
 
     {
@@ -138,10 +239,7 @@ void Logger::start(const Config& config) {
         if (started.load(std::memory_order_acquire)) {
             alreadyStarted = true;
         } else {
-            {
-                std::lock_guard<std::mutex> queueLock(queueMutex);
-                messageQueue.clear();
-            }
+            ring.clear();
 
 #ifdef _WIN32
             HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -158,6 +256,7 @@ void Logger::start(const Config& config) {
                 logStream.close();
             }
             saveToFile.store(false, std::memory_order_release);
+            binaryLog.close();
 
             if (config.getSaveLogs()) {
                 if (!std::filesystem::exists(logDirectory)) {
@@ -180,15 +279,25 @@ void Logger::start(const Config& config) {
 #else
                 name << getpid();
 #endif
-                name << ".log";
 
-                logStream.open(name.str(), std::ios::out | std::ios::app);
-                if (logStream.is_open()) {
-                    saveToFile.store(true, std::memory_order_release);
+                if (config.getLogFormat() == "binary") {
+                    std::string error;
+                    if (binaryLog.open(name.str(), wallClockOffset(), error)) {
+                        binaryLogPath = binaryLog.currentPath();
+                    } else {
+                        timestampLabel.clear();
+                        logOpenError = "Error: " + error;
+                    }
                 } else {
-                    timestampLabel.clear();
-                    saveToFile.store(false, std::memory_order_release);
-                    logOpenError = "Error: Failed to open log file: " + name.str();
+                    name << ".log";
+                    logStream.open(name.str(), std::ios::out | std::ios::app);
+                    if (logStream.is_open()) {
+                        saveToFile.store(true, std::memory_order_release);
+                    } else {
+                        timestampLabel.clear();
+                        saveToFile.store(false, std::memory_order_release);
+                        logOpenError = "Error: Failed to open log file: " + name.str();
+                    }
                 }
             }
 
@@ -199,6 +308,16 @@ void Logger::start(const Config& config) {
             pipeName = "/tmp/myiperflog_" + mode + "_" + config.getTargetIP() + "_" + std::to_string(config.getPort());
 #endif
             pipeConnected.store(false, std::memory_order_release);
+            flushInterval = std::chrono::milliseconds(config.getLogFlushMs());
+            maxLevel.store(static_cast<uint8_t>(parseLogLevel(config.getLogLevel())),
+                           std::memory_order_relaxed);
+
+            // Lines still batched when the process exits without calling stop() are written out.
+            static bool stopRegisteredAtExit = false;
+            if (!stopRegisteredAtExit) {
+                std::atexit(Logger::stop);
+                stopRegisteredAtExit = true;
+            }
 
             running.store(true, std::memory_order_release);
             started.store(true, std::memory_order_release);
@@ -215,12 +334,20 @@ void Logger::start(const Config& config) {
     if (!logOpenError.empty()) {
         log(logOpenError);
     }
+    if (static_cast<int>(parseLogLevel(config.getLogLevel())) > MYIPERF_COMPILED_LOG_LEVEL) {
+        MYIPERF_LOG_WARNING("--log-level {} requested, but messages of that level are not compiled "
+                            "into this build (configure with -DMYIPERF_ENABLE_DEBUG_LOGS=ON).",
+                            config.getLogLevel());
+    }
 
     if (!timestampLabel.empty()) {
         log("Info: Logger started " + timestampLabel);
     } else {
         log("Info: Logger started.");
     }
+    if (!binaryLogPath.empty()) {
+        log("Info: Writing binary log to " + binaryLogPath + " (read it with LogDecoder)");
+    }
     log("Info: IPEFTC version: " + buildInfoOneLine());
 
     std::ostringstream optionStream;
@@ -229,9 +356,24 @@ void Logger::start(const Config& config) {
                  << " --port " << config.getPort()
                  << " --packet-size " << config.getPacketSize()
                  << " --num-packets " << config.getNumPackets()
+                 << " --time " << config.getTestDuration()
+                 << " --omit " << config.getOmitSeconds()
                  << " --interval-ms " << config.getSendIntervalMs()
                  << " --save-logs " << (config.getSaveLogs() ? "true" : "false")
+                 << " --log-flush-ms " << config.getLogFlushMs()
+                 << " --log-level " << config.getLogLevel()
+                 << " --log-format " << config.getLogFormat()
                  << " --handshake-timeout-ms " << config.getHandshakeTimeoutMs()
+                 << " --backend " << config.getNetworkBackend()
+                 << " --parallel " << config.getParallelStreams()
+                 << " --zerocopy " << (config.getZeroCopy() ? "true" : "false")
+                 << " --batch " << config.getSendBatchSize()
+                 << " --integrity " << config.getIntegrity()
+                 << " --verify " << config.getVerification()
+                 << " --verify-sample " << config.getVerificationSampleInterval()
+                 << " --bitrate " << config.getBitrate()
+                 << " --busy-wait " << (config.getPacingBusyWait() ? "true" : "false")
+                 << " --pacing " << config.getPacing()
                  << " --quiet " << (isConsoleOutputEnabled() ? "true" : "false");
     log("Info: Options =>" + optionStream.str());
 }
@@ -251,7 +393,7 @@ void Logger::stop() {
         running.store(false, std::memory_order_release);
     }
 
-    cv.notify_all();
+    ring.wake();
 
     if (workerThread.joinable()) {
         workerThread.join();
@@ -277,6 +419,15 @@ void Logger::stop() {
     pipeThread = std::thread();
 
 #ifndef _WIN32
+    if (pipeFd != -1) {
+        if (!pipeCarry.empty()) {
+            writeAvailable(pipeFd, pipeCarry);
+        }
+        close(pipeFd);
+        pipeFd = -1;
+    }
+    pipeCarry.clear();
+    nextPipeOpen = {};
     if (std::filesystem::exists(pipeName)) {
         unlink(pipeName.c_str());
     }
@@ -287,11 +438,9 @@ void Logger::stop() {
         logStream.close();
     }
     saveToFile.store(false, std::memory_order_release);
+    binaryLog.close();
 
-    {
-        std::lock_guard<std::mutex> queueLock(queueMutex);
-        messageQueue.clear();
-    }
+    ring.clear();
 
     started.store(false, std::memory_order_release);
 }
@@ -299,86 +448,280 @@ void Logger::stop() {
 /**
  * @brief Logs a message.
  *
- * This function adds a message to the logger's queue to be processed by the worker thread.
- * It is thread-safe.
+ * This function copies the message into the logger's ring to be formatted and
+ * written by the worker thread. It is thread-safe and never blocks; if the
+ * ring is full the message is dropped and counted. Messages above the
+ * --log-level threshold are discarded first.
  *
  * @param message The message to log.
  */
 void Logger::log(const std::string& message) {
-    if (!kDebugLogsEnabled && isDebugLine(message)) {
+    const LogLevel level = levelOf(message);
+    if (static_cast<int>(level) > MYIPERF_COMPILED_LOG_LEVEL || !isEnabled(level)) {
         return;
     }
 
     if (!started.load(std::memory_order_acquire)) {
-        std::lock_guard<std::mutex> lock(immediateMutex);
-        const std::string formatted = buildTimestampedLine(message);
-        const std::string colored = colorizeLine(message, formatted);
-        if (consoleOutput) {
-            std::cout << colored << std::endl;
-        }
+        logImmediately(message);
         return;
     }
 
-    {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        messageQueue.push_back(message);
+    ring.push(level, LogRing::Encoding::Text, LogRing::Clock::now(), message);
+}
+
+std::string& Logger::encodeBuffer() {
+    thread_local std::string buffer;
+    return buffer;
+}
+
+void Logger::enqueueFormatted(LogLevel level, const std::string& encoded) {
+    if (!started.load(std::memory_order_acquire)) {
+        std::string message = levelTag(level);
+        LogFormatting::render(message, encoded);
+        logImmediately(message);
+        return;
+    }
+
+    ring.push(level, LogRing::Encoding::Format, LogRing::Clock::now(), encoded);
+}
+
+/**
+ * @brief Prints a message on the calling thread while the worker is not running.
+ */
+void Logger::logImmediately(const std::string& message) {
+    std::lock_guard<std::mutex> lock(immediateMutex);
+    const std::string formatted = buildTimestampedLine(message);
+    const std::string colored = colorizeLine(message, formatted);
+    if (consoleOutput) {
+        std::cout << colored << std::endl;
     }
-    cv.notify_one();
 }
 
 /**
  * @brief The main function for the logger worker thread.
  *
- * This function runs on a dedicated thread and is responsible for taking messages
- * from the queue and writing them to the console and optional log file.
+ * This function runs on a dedicated thread and is responsible for taking
+ * records from the ring. Each record is copied into the binary log, if one
+ * is open, as it is; only when a text output wants the line is the message
+ * rendered and its timestamp formatted. Formatted lines are collected into a
+ * batch that is written to each output with one call once the ring is
+ * drained and the oldest line has waited flushInterval, or the batch has
+ * grown large. Whatever is left is written before the thread exits.
  */
 void Logger::logWorker() {
-    while (true) {
-        std::deque<std::string> writeQueue;
-        {
-            std::unique_lock<std::mutex> lock(queueMutex);
-            cv.wait(lock, [] { return !messageQueue.empty() || !running.load(std::memory_order_acquire); });
-            if (!running.load(std::memory_order_acquire) && messageQueue.empty()) {
-                break;
+#ifndef _WIN32
+    // A pipe reader that goes away must show up as EPIPE from write(), not kill the process.
+    sigset_t pipeSignal;
+    sigemptyset(&pipeSignal);
+    sigaddset(&pipeSignal, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &pipeSignal, nullptr);
+#endif
+
+    TimestampFormatter timestamps;
+    LogRing::Record record;
+    std::string rendered;
+    bool havePending = false;
+    uint64_t reportedDrops = ring.dropped();
+    LogRing::Clock::time_point lastDropReport;
+
+    std::string lines;         // Plain text for the log file and the pipe.
+    std::string coloredLines;  // The same lines with console colours.
+    LogRing::Clock::time_point batchStart;
+    std::string binaryLogError;
+
+    auto appendText = [&](const std::string& message, LogRing::Clock::time_point time) {
+        if (lines.empty()) {
+            batchStart = time;
+        }
+        const size_t lineStart = lines.size();
+        lines += timestamps.prefix(time);
+        lines += message;
+        if (consoleOutput) {
+            const std::string_view line(lines.data() + lineStart, lines.size() - lineStart);
+            if (const char* color = colorOf(message)) {
+                coloredLines += color;
+                coloredLines += line;
+                coloredLines += kColorReset;
+            } else {
+                coloredLines += line;
             }
-            writeQueue.swap(messageQueue);
+            coloredLines += '\n';
+        }
+        lines += '\n';
+    };
+    auto append = [&](LogLevel level, LogRing::Encoding encoding, const std::string& payload,
+                      LogRing::Clock::time_point time) {
+        if (binaryLog.isOpen()) {
+            const bool stored = encoding == LogRing::Encoding::Format
+                                    ? binaryLog.appendFormatted(level, time, payload, binaryLogError)
+                                    : binaryLog.appendText(level, time, payload, binaryLogError);
+            if (!stored) {
+                appendText("Error: " + binaryLogError + "; binary logging stopped.", time);
+                binaryLog.close();
+            }
+        }
+        if (!hasTextOutput(time)) {
+            return;
+        }
+        if (encoding == LogRing::Encoding::Format) {
+            rendered = levelTag(level);
+            LogFormatting::render(rendered, payload);
+            appendText(rendered, time);
+        } else {
+            appendText(payload, time);
+        }
+    };
+    auto write = [&]() {
+        writeBatch(lines, coloredLines);
+        lines.clear();
+        coloredLines.clear();
+    };
+
+    while (true) {
+        if (!havePending) {
+            havePending = ring.pop(record);
+        }
+
+        // Drops are reported from here rather than through the ring, which may
+        // be full again; during a sustained flood at most once per interval.
+        const uint64_t drops = ring.dropped();
+        const LogRing::Clock::time_point now = havePending ? record.time : LogRing::Clock::now();
+        if (drops != reportedDrops && (!havePending || now - lastDropReport >= kDropReportInterval)) {
+            append(LogLevel::Warning, LogRing::Encoding::Text,
+                   "Warning: Logger dropped " + std::to_string(drops - reportedDrops) +
+                       " messages because the log ring was full.",
+                   now);
+            reportedDrops = drops;
+            lastDropReport = now;
+            continue;
         }
 
-        for (const auto& msg : writeQueue) {
-            const std::string formatted = buildTimestampedLine(msg);
-            const std::string colored = colorizeLine(msg, formatted);
-            if (consoleOutput) {
-                std::cout << colored << std::endl;
+        if (havePending) {
+            append(record.level, record.encoding, record.payload, record.time);
+            havePending = false;
+            // With a zero interval the batch is whatever one drain of the ring yields.
+            if (lines.size() >= kMaxBatchBytes ||
+                (flushInterval.count() > 0 && record.time - batchStart >= flushInterval)) {
+                write();
             }
+            continue;
+        }
 
-            if (saveToFile.load(std::memory_order_acquire) && logStream.is_open()) {
-                logStream << formatted << std::endl;
-                logStream.flush();
+        const bool keepRunning = running.load(std::memory_order_acquire);
+        if (!lines.empty()) {
+            const LogRing::Clock::duration age = LogRing::Clock::now() - batchStart;
+            if (age >= flushInterval || !keepRunning) {
+                write();
+            } else {
+                ring.waitForRecords(std::min<LogRing::Clock::duration>(kWorkerIdleWait, flushInterval - age));
             }
+        } else if (keepRunning) {
+            ring.waitForRecords(kWorkerIdleWait);
+        } else {
+            break;
+        }
+    }
+}
 
-            if (pipeConnected.load(std::memory_order_acquire)) {
+bool Logger::hasTextOutput(std::chrono::steady_clock::time_point time) {
+    if (consoleOutput || saveToFile.load(std::memory_order_acquire)) {
+        return true;
+    }
+    if (!pipeConnected.load(std::memory_order_acquire)) {
+        return false;
+    }
 #ifdef _WIN32
-                DWORD bytesWritten;
-                BOOL success = WriteFile((HANDLE)hPipe, formatted.c_str(), formatted.length(), &bytesWritten, NULL);
-                if (!success) {
-                    pipeConnected.store(false, std::memory_order_release);
-                }
+    (void)time;
+    return true;
 #else
-                int fd = open(pipeName.c_str(), O_WRONLY | O_NONBLOCK);
-                if (fd != -1) {
-                    std::string payload = formatted + "\n";
-                    ssize_t written = write(fd, payload.c_str(), payload.length());
-                    close(fd);
-                    if (written == -1) {
-                         // Handling write error if necessary
-                    }
-                } else {
-                     // Could not open pipe (no reader?)
-                     // pipeConnected might remain true to keep trying, or we can check errno
-                }
+    // Without a reader the lines would only be formatted to be thrown away;
+    // the next batch after nextPipeOpen still tries to open the FIFO.
+    return pipeFd != -1 || time >= nextPipeOpen;
 #endif
+}
+
+/**
+ * @brief Writes a batch of formatted lines to the console, the log file and the pipe.
+ * @param lines Newline-terminated lines without colours.
+ * @param coloredLines The same lines with console colours.
+ */
+void Logger::writeBatch(const std::string& lines, const std::string& coloredLines) {
+    if (consoleOutput && !coloredLines.empty()) {
+        std::cout.write(coloredLines.data(), static_cast<std::streamsize>(coloredLines.size()));
+        std::cout.flush();
+    }
+
+    if (saveToFile.load(std::memory_order_acquire) && logStream.is_open()) {
+        logStream.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+        logStream.flush();
+    }
+
+    if (pipeConnected.load(std::memory_order_acquire)) {
+#ifdef _WIN32
+        DWORD bytesWritten;
+        BOOL success = WriteFile((HANDLE)hPipe, lines.data(), static_cast<DWORD>(lines.size()), &bytesWritten, NULL);
+        if (!success) {
+            pipeConnected.store(false, std::memory_order_release);
+        }
+#else
+        // The FIFO stays open while a reader is attached. Without one, open()
+        // fails with ENXIO and is retried at most once per kPipeReopenInterval.
+        if (pipeFd == -1) {
+            const auto now = std::chrono::steady_clock::now();
+            if (now < nextPipeOpen) {
+                return;
+            }
+            pipeFd = open(pipeName.c_str(), O_WRONLY | O_NONBLOCK);
+            if (pipeFd == -1) {
+                nextPipeOpen = now + kPipeReopenInterval;
+                return;
             }
         }
+        // The batch is written in runs of whole lines of at most PIPE_BUF bytes,
+        // which the pipe takes entirely or not at all. When it is full the
+        // remaining lines are dropped for the pipe only, so the reader never
+        // sees a line cut short; only a line longer than PIPE_BUF can be taken
+        // in part, and its rest is kept in pipeCarry and written ahead of the
+        // next batch. A reader that closed (EPIPE) makes the next batch reopen
+        // the FIFO.
+        if (!pipeCarry.empty()) {
+            const ssize_t written = writeAvailable(pipeFd, pipeCarry);
+            if (written == -1) {
+                close(pipeFd);
+                pipeFd = -1;
+                pipeCarry.clear();
+                return;
+            }
+            pipeCarry.erase(0, static_cast<size_t>(written));
+            if (!pipeCarry.empty()) {
+                return;
+            }
+        }
+        size_t offset = 0;
+        while (offset < lines.size()) {
+            size_t end = lines.size();
+            if (end - offset > PIPE_BUF) {
+                end = lines.rfind('\n', offset + PIPE_BUF - 1) + 1;
+                if (end <= offset) {
+                    end = lines.find('\n', offset) + 1;
+                }
+            }
+            const ssize_t written = writeAvailable(pipeFd, std::string_view(lines).substr(offset, end - offset));
+            if (written == -1) {
+                close(pipeFd);
+                pipeFd = -1;
+                return;
+            }
+            const size_t taken = static_cast<size_t>(written);
+            if (taken < end - offset) {
+                if (taken > 0) {
+                    pipeCarry.assign(lines, offset + taken, end - offset - taken);
+                }
+                return;
+            }
+            offset = end;
+        }
+#endif
     }
 }
 
@@ -430,6 +773,20 @@ bool Logger::isConsoleOutputEnabled() {
     return consoleOutput;
 }
 
+const char* Logger::levelTag(LogLevel level) {
+    switch (level) {
+    case LogLevel::Error: return "Error: ";
+    case LogLevel::Warning: return "Warning: ";
+    case LogLevel::Debug: return "Debug: ";
+    case LogLevel::Info: break;
+    }
+    return "Info: ";
+}
+
+uint64_t Logger::droppedMessages() {
+    return ring.dropped();
+}
+
 /**
  * @brief The main function for the pipe connection worker thread.
  */
@@ -1,15 +1,32 @@
 #include "NetworkInterfaceFactory.h"
+#include "myiperf/Logger.h"
 
 #ifdef _WIN32
 #include "platform/WinIOCPNetworkInterface.h"
 #else
 #include "platform/LinuxAsyncNetworkInterface.h"
+#if defined(MYIPERF_HAS_IO_URING)
+#include "platform/LinuxUringNetworkInterface.h"
+#endif
 #endif
 
-std::unique_ptr<NetworkInterface> createNetworkInterface() {
+std::unique_ptr<NetworkInterface> createNetworkInterface(const std::string& backend) {
 #ifdef _WIN32
+  if (backend != "default") {
+    Logger::log("Warning: Network backend '" + backend + "' is not available on Windows. Using IOCP.");
+  }
   return std::make_unique<WinIOCPNetworkInterface>();
 #else
+  if (backend == "io_uring") {
+#if defined(MYIPERF_HAS_IO_URING)
+    if (LinuxUringNetworkInterface::isSupported()) {
+      return std::make_unique<LinuxUringNetworkInterface>();
+    }
+    Logger::log("Warning: io_uring is not permitted by this kernel. Using epoll.");
+#else
+    Logger::log("Warning: This build has no io_uring support. Using epoll.");
+#endif
+  }
   return std::make_unique<LinuxAsyncNetworkInterface>();
 #endif
 }
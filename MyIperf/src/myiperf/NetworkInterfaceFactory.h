@@ -1,7 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 class NetworkInterface;
 
-std::unique_ptr<NetworkInterface> createNetworkInterface();
+/**
+ * @brief Creates the asynchronous network backend for this platform.
+ * @param backend "default", "epoll" or "io_uring". Backends that are not
+ *        available in this build or on this kernel fall back to the platform
+ *        default with a warning.
+ */
+std::unique_ptr<NetworkInterface> createNetworkInterface(const std::string& backend = "default");
@@ -6,40 +6,56 @@
 
 PacketDispatcher::PacketDispatcher(ControlMessageBus& messages,
                                    PacketReceiveStats& stats)
-    : messages(messages), stats(stats) {}
+    : messages(messages), stats(stats), receiveLog("PacketReceiver received") {}
 
 void PacketDispatcher::dispatch(const std::vector<ParsedPacket>& packets) {
+    // Consecutive data packets are summarised as one receive call.
+    uint32_t runFirst = 0;
+    uint32_t runPackets = 0;
+    uint64_t runBytes = 0;
+    const auto recordRun = [&]() {
+        if (runPackets > 0) {
+            receiveLog.record(runFirst, runPackets, runBytes);
+            runPackets = 0;
+            runBytes = 0;
+        }
+    };
+
     for (const auto& packet : packets) {
-#ifdef DEBUG_LOG
-        Logger::log("Debug: PacketDispatcher dispatching packet. Message Type: "
-                    + std::to_string(static_cast<int>(packet.header.messageType))
-                    + ", Packet Counter: "
-                    + std::to_string(packet.header.packetCounter)
-                    + ", payloadSize: "
-                    + std::to_string(packet.header.payloadSize));
-#endif
+        MYIPERF_LOG_DEBUG("PacketDispatcher dispatching packet. Message Type: {}, Packet Counter: {}, payloadSize: {}",
+                          static_cast<int>(packet.header.messageType), packet.header.packetCounter,
+                          packet.header.payloadSize);
 
         if (packet.header.messageType == MessageType::DATA_PACKET) {
             stats.onDataPacket(packet);
-            Logger::log("Info: PacketReceiver received DATA_PACKET "
-                        + std::to_string(packet.header.packetCounter)
-                        + " (size: " + std::to_string(packet.totalPacketSize)
-                        + " bytes)");
+            if (runPackets == 0) {
+                runFirst = packet.header.packetCounter;
+            }
+            ++runPackets;
+            runBytes += packet.totalPacketSize;
             continue;
         }
 
-        Logger::log("CONTROL: PacketReceiver forwarding control message "
-                    + std::string(ControlProtocol::messageTypeToString(
-                          packet.header.messageType))
-                    + " (messageType="
-                    + std::to_string(static_cast<int>(packet.header.messageType))
-                    + ", packetCounter="
-                    + std::to_string(packet.header.packetCounter)
-                    + ", totalPacketSize="
-                    + std::to_string(packet.totalPacketSize)
-                    + " bytes, payloadSize="
-                    + std::to_string(packet.header.payloadSize)
-                    + " bytes)");
+        // The data before a control message is summarised ahead of it.
+        recordRun();
+        receiveLog.flush();
+        if (packet.header.messageType == MessageType::OMIT_END) {
+            // Only the stats care; nothing waits for it on the message bus.
+            stats.endOmitWindow();
+            MYIPERF_LOG_INFO("CONTROL: PacketReceiver received OMIT_END. Measurement starts.");
+            continue;
+        }
+
+        MYIPERF_LOG_INFO("CONTROL: PacketReceiver forwarding control message {} (messageType={}, "
+                         "packetCounter={}, totalPacketSize={} bytes, payloadSize={} bytes)",
+                         ControlProtocol::messageTypeToString(packet.header.messageType),
+                         static_cast<int>(packet.header.messageType), packet.header.packetCounter,
+                         packet.totalPacketSize, packet.header.payloadSize);
         messages.deliver(packet.header, packet.payload);
     }
+    recordRun();
+}
+
+void PacketDispatcher::flush() {
+    receiveLog.flush();
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "DataPathEventLog.h"
 #include "PacketReceiveStats.h"
 
 #include <vector>
@@ -12,7 +13,11 @@ public:
 
     void dispatch(const std::vector<ParsedPacket>& packets);
 
+    /** @brief Writes the pending data packet summary. */
+    void flush();
+
 private:
     ControlMessageBus& messages;
     PacketReceiveStats& stats;
+    DataPathEventLog receiveLog;
 };
@@ -1,65 +1,108 @@
 #include "PacketGenerator.h"
+#include "ControlProtocol.h"
 #include "myiperf/Logger.h"
 #include "myiperf/Protocol.h"
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
 #include <cstring>
+#include <span>
 #include <thread> // For std::this_thread::yield()
 #include <type_traits>
 
+namespace {
+
+/**< The pacer may catch up on this much lateness, e.g. a timer that fired late. */
+constexpr std::chrono::microseconds kPacingBurst{1000};
+/**< With --busy-wait, shorter gaps are spun; a timer wait costs more than that. */
+constexpr std::chrono::microseconds kBusyWaitThreshold{10};
+/**< Unpaced sends between clock reads for the --time deadline and the --omit window. */
+constexpr int kClockCheckInterval = 64;
+
+} // namespace
+
 /**
  * @brief Constructs the PacketGenerator.
  * @param netInterface Pointer to the network interface for sending packets.
  */
 PacketGenerator::PacketGenerator(NetworkInterface* netInterface)
-    : networkInterface(netInterface), running(false), totalBytesSent(0), packetCounter(0) {}
+    : networkInterface(netInterface), running(false), totalBytesSent(0), packetCounter(0),
+      sendLog("PacketGenerator sent") {}
 
 /**
  * @brief Stops the packet generation process.
  */
 void PacketGenerator::stop() {
-    Logger::log("Debug: PacketGenerator::stop entered.");
+    MYIPERF_LOG_DEBUG("PacketGenerator::stop entered.");
     
     const bool wasRunning = running.exchange(false);
     if (!wasRunning) {
-        Logger::log("Debug: PacketGenerator was already stopped.");
+        MYIPERF_LOG_DEBUG("PacketGenerator was already stopped.");
     }
     
     m_endTime = std::chrono::steady_clock::now();
-    Logger::log("Info: PacketGenerator stopped.");
-    Logger::log("Debug: PacketGenerator::stop exited.");
+    MYIPERF_LOG_INFO("PacketGenerator stopped.");
+    MYIPERF_LOG_DEBUG("PacketGenerator::stop exited.");
 }
 
-std::vector<char> PacketGenerator::createPacket() {
+void PacketGenerator::preparePacketTemplate() {
     const size_t packetSize = config.getPacketSize();
-    if (packetSize < sizeof(PacketHeader)) {
-        return {}; // Invalid packet size
-    }
-
-    // 1. Build the payload and calculate the checksum for the CURRENT packet.
     const size_t payloadSize = packetSize - sizeof(PacketHeader);
-    std::string payload_str = buildExpectedPayload(packetCounter, payloadSize);
-    uint32_t checksum = calculateChecksum(payload_str.data(), payloadSize);
 
-    // 2. Construct the header with the correct, unique information.
+    // The payload of every packet is buildExpectedPayload(): "Packet N" padded with '.'.
+    packetTemplate.assign(packetSize, '.');
+    templatePayloadSum = static_cast<uint32_t>(payloadSize) * static_cast<uint32_t>('.');
+
     PacketHeader header;
     header.startCode = PROTOCOL_START_CODE;
     header.senderId = static_cast<std::underlying_type_t<Config::TestMode>>(config.getMode());
     header.receiverId = static_cast<std::underlying_type_t<Config::TestMode>>((config.getMode() == Config::TestMode::CLIENT) ? Config::TestMode::SERVER : Config::TestMode::CLIENT);
     header.messageType = MessageType::DATA_PACKET;
-    header.packetCounter = packetCounter;
+    header.packetCounter = 0;
     header.payloadSize = static_cast<uint32_t>(payloadSize);
-    header.checksum = checksum;
+    header.checksum = 0;
+    memcpy(packetTemplate.data(), &header, sizeof(PacketHeader));
+}
 
-    // 3. Assemble the final packet for sending.
-    std::vector<char> packet(packetSize);
-    memcpy(packet.data(), &header, sizeof(PacketHeader));
-    if (payloadSize > 0) {
-        memcpy(packet.data() + sizeof(PacketHeader), payload_str.data(), payloadSize);
+void PacketGenerator::fillSendBuffer(int batchSize) {
+    const size_t slots = static_cast<size_t>(batchSize);
+    if (sendBuffer.size() == slots * packetTemplate.size()) {
+        return;
+    }
+    sendBuffer.resize(slots * packetTemplate.size());
+    for (size_t i = 0; i < slots; ++i) {
+        memcpy(sendBuffer.data() + i * packetTemplate.size(), packetTemplate.data(), packetTemplate.size());
     }
+}
+
+void PacketGenerator::writePacket(char* slot) {
+    const size_t payloadSize = packetTemplate.size() - sizeof(PacketHeader);
+    char* payload = slot + sizeof(PacketHeader);
+
+    // 1. Patch the "Packet N" prefix over the '.' fill.
+    char prefix[32] = "Packet ";
+    const auto digits = std::to_chars(prefix + 7, prefix + sizeof(prefix), packetCounter);
+    const size_t prefixSize = std::min(static_cast<size_t>(digits.ptr - prefix), payloadSize);
+    memcpy(payload, prefix, prefixSize);
+
+    // 2. Checksum the CURRENT packet. The sum only changes by the patched bytes;
+    //    the other algorithms mix every byte and hash the patched payload once.
+    uint32_t checksum;
+    if (integrity == IntegrityAlgorithm::SUM) {
+        checksum = templatePayloadSum;
+        for (size_t i = 0; i < prefixSize; ++i) {
+            checksum += static_cast<uint32_t>(static_cast<unsigned char>(prefix[i])) - static_cast<uint32_t>('.');
+        }
+    } else {
+        checksum = calculateIntegrity(integrity, payload, payloadSize);
+    }
+
+    // 3. Patch the per-packet header fields.
+    memcpy(slot + offsetof(PacketHeader, packetCounter), &packetCounter, sizeof(packetCounter));
+    memcpy(slot + offsetof(PacketHeader, checksum), &checksum, sizeof(checksum));
 
     // 4. Increment the counter for the next packet.
     packetCounter++;
-
-    return packet;
 }
 
 /**
@@ -81,6 +124,14 @@ TestStats PacketGenerator::getStats() {
     TestStats stats;
     stats.totalBytesSent = totalBytesSent.load();
     stats.totalPacketsSent = totalPacketsSent.load();
+    stats.sendOperations = totalSendOperations.load();
+    stats.omittedDuration = std::chrono::duration<double>(m_omittedDuration).count();
+    stats.omittedBytes = omittedBytesSent.load();
+    stats.omittedPackets = omittedPacketsSent.load();
+    if (pacer.enabled()) {
+        stats.targetBitrate = config.getBitrate();
+        stats.pacing = kernelPacing ? "kernel" : "user";
+    }
     if (m_endTime > m_startTime) {
         stats.duration = std::chrono::duration<double>(m_endTime - m_startTime).count();
         if (stats.duration > 0) {
@@ -95,7 +146,7 @@ TestStats PacketGenerator::getStats() {
 }
 
 void PacketGenerator::saveLastStats(const TestStats& Stats) {
-    std::memcpy(&m_LastStats, &Stats, sizeof(TestStats));
+    m_LastStats = Stats;
 }
 
 TestStats PacketGenerator::lastStats() const{
@@ -106,57 +157,202 @@ TestStats PacketGenerator::lastStats() const{
  * @brief Resets the generator's statistics for a new test phase.
  */
 void PacketGenerator::resetStats() {
-    Logger::log("Debug: PacketGenerator::resetStats entered.");
+    MYIPERF_LOG_DEBUG("PacketGenerator::resetStats entered.");
     totalBytesSent = 0;
     totalPacketsSent = 0;
+    totalSendOperations = 0;
+    omittedBytesSent = 0;
+    omittedPacketsSent = 0;
+    m_omittedDuration = {};
     packetCounter = 0;
     m_startTime = std::chrono::steady_clock::now();
     m_endTime = std::chrono::steady_clock::time_point(); // Reset end time
-    Logger::log("Debug: PacketGenerator::resetStats exited.");
+    MYIPERF_LOG_DEBUG("PacketGenerator::resetStats exited.");
+}
+
+Task PacketGenerator::endOmitWindow() {
+    sendLog.flush();
+    // Everything counted so far precedes OMIT_END on the wire, so the receiver
+    // moves exactly these bytes into its omitted window as well.
+    omittedBytesSent = totalBytesSent.load();
+    omittedPacketsSent = totalPacketsSent.load();
+    totalBytesSent = 0;
+    totalPacketsSent = 0;
+    totalSendOperations = 0;
+    co_await ControlProtocol::sendControlPacket(*networkInterface, MessageType::OMIT_END);
+
+    const auto now = std::chrono::steady_clock::now();
+    m_omittedDuration = now - m_startTime;
+    m_startTime = now;
+    MYIPERF_LOG_INFO("PacketGenerator omit window ended after {} packets. Measurement starts.",
+                     omittedPacketsSent.load());
 }
 
 Task PacketGenerator::sendPackets(const Config& cfg) {
-    Logger::log("Debug: PacketGenerator::sendPackets entered.");
-    Logger::log("Info: Client test parameters - packetSize=" + std::to_string(cfg.getPacketSize()) +
-               ", numPackets=" + std::to_string(cfg.getNumPackets()) +
-               ", intervalMs=" + std::to_string(cfg.getSendIntervalMs()));
+    MYIPERF_LOG_DEBUG("PacketGenerator::sendPackets entered.");
+    MYIPERF_LOG_INFO("Client test parameters - packetSize={}, numPackets={}, durationSec={}, omitSec={}, "
+                     "intervalMs={}, batch={}, bitrate={}, pacing={}, integrity={}",
+                     cfg.getPacketSize(), cfg.getNumPackets(), cfg.getTestDuration(), cfg.getOmitSeconds(),
+                     cfg.getSendIntervalMs(), cfg.getSendBatchSize(), cfg.getBitrate(), cfg.getPacing(),
+                     cfg.getIntegrity());
 
     this->config = cfg;
+    integrity = IntegrityAlgorithm::SUM;
+    parseIntegrityAlgorithm(cfg.getIntegrity(), integrity);
     running = true;
     totalBytesSent = 0;
     totalPacketsSent = 0;
+    totalSendOperations = 0;
+    omittedBytesSent = 0;
+    omittedPacketsSent = 0;
+    m_omittedDuration = {};
     packetCounter = 0;
     m_startTime = std::chrono::steady_clock::now();
-    memset(&m_LastStats, 0, sizeof(TestStats));
+    m_LastStats = TestStats{};
+
+    MYIPERF_LOG_INFO("PacketGenerator coroutine started.");
+
+    // Zero-copy sends keep their buffer pinned after completion, so they hand each batch
+    // over. Otherwise one buffer is reused and only lent to the backend per send.
+    bool zeroCopy = cfg.getZeroCopy();
+    if (!networkInterface->setZeroCopySend(zeroCopy)) {
+        MYIPERF_LOG_WARNING("Zero-copy send is not available on this network backend. Sending with copies.");
+        zeroCopy = false;
+    }
+
+    const size_t packetSize = static_cast<size_t>(cfg.getPacketSize());
+    const int batchSize = cfg.getSendBatchSize();
 
-    Logger::log("Info: PacketGenerator coroutine started.");
+    // Counters restart at 0, so slots left over from an earlier run may hold
+    // longer prefixes than the new packets would overwrite.
+    sendBuffer.clear();
+    if (packetSize >= sizeof(PacketHeader)) {
+        preparePacketTemplate();
+    }
+
+    // Sends are paced against a fixed schedule, so the time spent sending does
+    // not stretch the interval. --bitrate takes precedence over --interval-ms.
+    const auto sendInterval = cfg.getBitrate() > 0
+        ? std::chrono::milliseconds(0)
+        : std::chrono::milliseconds(cfg.getSendIntervalMs());
+    auto nextSendTime = std::chrono::steady_clock::now();
+    const size_t burstBytes = std::max(
+        packetSize * static_cast<size_t>(batchSize),
+        static_cast<size_t>(static_cast<double>(cfg.getBitrate()) / 8.0
+                            * std::chrono::duration<double>(kPacingBurst).count()));
+    pacer.start(cfg.getBitrate(), burstBytes, nextSendTime);
+    const bool busyWait = cfg.getPacingBusyWait();
+
+    // Paced and interval sends already know when they would happen and stop
+    // before a send that would fall past the deadline. Unpaced sends read the
+    // clock only every kClockCheckInterval sends. The --time limit starts
+    // after the --omit window.
+    const auto toClock = [](double seconds) {
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds));
+    };
+    const auto omitEnd = m_startTime + toClock(cfg.getOmitSeconds());
+    bool omitPending = cfg.getOmitSeconds() > 0.0;
+    const bool timeLimited = cfg.getTestDuration() > 0.0;
+    const auto deadline = omitEnd + toClock(cfg.getTestDuration());
+    const int clockCheckInterval = (pacer.enabled() || sendInterval.count() > 0) ? 1 : kClockCheckInterval;
+    int sendsUntilClockCheck = clockCheckInterval;
+    bool deadlineReached = false;
+
+    // Under kernel pacing the socket holds the sends back. The pacer then only
+    // keeps the books, so that the run ends when the capped socket has drained.
+    kernelPacing = false;
+    if (pacer.enabled() && cfg.getPacing() == "kernel") {
+        const uint64_t bytesPerSecond = static_cast<uint64_t>(cfg.getBitrate() / 8);
+        if (networkInterface->setPacingRate(bytesPerSecond)) {
+            kernelPacing = true;
+            MYIPERF_LOG_INFO("Kernel pacing enabled (SO_MAX_PACING_RATE {} bytes/s).", bytesPerSecond);
+        } else {
+            MYIPERF_LOG_WARNING("Kernel pacing is not available on this network backend. Pacing in user space.");
+        }
+    }
 
     try {
         while (running && shouldContinueSending()) {
-            // Create and send packet
-            auto packet = createPacket();
-            if (packet.empty()) {
-                Logger::log("Error: Failed to create packet. Stopping generator.");
+            if (packetSize < sizeof(PacketHeader)) {
+                MYIPERF_LOG_ERROR("Failed to create packet. Stopping generator.");
                 break;
             }
 
-            // Send packet using coroutine
-            size_t bytesSent = co_await networkInterface->send(packet);
+            // Assemble up to batchSize packets back to back in one buffer so that a
+            // single send call carries all of them.
+            const uint32_t firstPacket = packetCounter;
+            fillSendBuffer(batchSize);
+            int packetsInBatch = 0;
+            do {
+                writePacket(sendBuffer.data() + packetSize * static_cast<size_t>(packetsInBatch));
+                ++packetsInBatch;
+            } while (packetsInBatch < batchSize && shouldContinueSending());
+
+            // Send the batch using coroutine. The buffer is never copied on the way down.
+            const size_t batchBytes = packetSize * static_cast<size_t>(packetsInBatch);
+            if (pacer.enabled()) {
+                const auto now = std::chrono::steady_clock::now();
+                // Checked before reserving, so drainedAt() stays at the last batch sent.
+                if (timeLimited && std::max(now, pacer.drainedAt()) >= deadline) {
+                    deadlineReached = true;
+                    break;
+                }
+                const auto sendAt = pacer.reserve(batchBytes, now);
+                if (sendAt > now && !kernelPacing) {
+                    if (busyWait && sendAt - now < kBusyWaitThreshold) {
+                        while (std::chrono::steady_clock::now() < sendAt) {
+                        }
+                    } else {
+                        co_await networkInterface->sleepUntil(sendAt);
+                    }
+                }
+            }
+            if (zeroCopy) {
+                sendBuffer.resize(batchBytes);
+            }
+            size_t bytesSent = zeroCopy
+                ? co_await networkInterface->send(std::move(sendBuffer))
+                : co_await networkInterface->sendFrom(std::span<const char>(sendBuffer.data(), batchBytes));
 
             if (bytesSent > 0) {
                 totalBytesSent += bytesSent;
-                totalPacketsSent++;
-                Logger::log("Info: PacketGenerator sent packet " + std::to_string(packetCounter - 1) +
-                           " (size: " + std::to_string(packet.size()) + " bytes)");
+                totalPacketsSent += packetsInBatch;
+                totalSendOperations++;
+                sendLog.record(firstPacket, static_cast<uint32_t>(packetsInBatch), batchBytes);
             } else {
-                Logger::log("Warning: Send operation failed or sent 0 bytes. Stopping generator.");
+                MYIPERF_LOG_WARNING("Send operation failed or sent 0 bytes. Stopping generator.");
                 break;
             }
 
-            // Wait for interval if specified
-            if (cfg.getSendIntervalMs() > 0) {
-                co_await delay(std::chrono::milliseconds(cfg.getSendIntervalMs()));
-            } else {
+            if ((omitPending || timeLimited) && --sendsUntilClockCheck == 0) {
+                sendsUntilClockCheck = clockCheckInterval;
+                const auto now = std::chrono::steady_clock::now();
+                if (omitPending && now >= omitEnd) {
+                    omitPending = false;
+                    co_await endOmitWindow();
+                }
+                if (timeLimited && now >= deadline) {
+                    deadlineReached = true;
+                    break;
+                }
+            }
+
+            // Wait for interval if specified. The interval applies per send call.
+            // The backend's timer resumes this coroutine on its I/O thread.
+            if (sendInterval.count() > 0) {
+                nextSendTime += sendInterval;
+                const auto now = std::chrono::steady_clock::now();
+                if (nextSendTime < now) {
+                    nextSendTime = now; // Fell behind; do not catch up with a burst.
+                }
+                if (timeLimited && nextSendTime >= deadline) {
+                    // The last interval still belongs to the phase.
+                    co_await networkInterface->sleepUntil(deadline);
+                    deadlineReached = true;
+                    break;
+                }
+                co_await networkInterface->sleepUntil(nextSendTime);
+            } else if (!pacer.enabled()) {
                 // Yield to prevent 100% CPU usage while maintaining maximum throughput.
                 // Do not suspend the coroutine here; no external event would resume it.
                 std::this_thread::yield();
@@ -168,12 +364,26 @@ Task PacketGenerator::sendPackets(const Config& cfg) {
     } catch (const std::exception& e) {
         Logger::log("Error in sendPackets coroutine: " + std::string(e.what()));
     }
+    sendLog.flush();
+
+    if (running && pacer.enabled()) {
+        // The last send's share of time ends when its tokens are paid for; without
+        // this wait a paced run would appear faster than the target.
+        co_await networkInterface->sleepUntil(pacer.drainedAt());
+    }
+    if (kernelPacing) {
+        networkInterface->setPacingRate(0); // Control messages that follow are not data.
+    }
 
     if (running) { // If we exited the loop because we finished, not because we were stopped
         running = false;
         m_endTime = std::chrono::steady_clock::now();
-        Logger::log("Info: PacketGenerator reached target packet count: " + std::to_string(cfg.getNumPackets()));
+        if (deadlineReached) {
+            MYIPERF_LOG_INFO("PacketGenerator reached test duration: {} s", cfg.getTestDuration());
+        } else {
+            MYIPERF_LOG_INFO("PacketGenerator reached target packet count: {}", cfg.getNumPackets());
+        }
     }
 
-    Logger::log("Debug: PacketGenerator::sendPackets exited.");
+    MYIPERF_LOG_DEBUG("PacketGenerator::sendPackets exited.");
 }
@@ -4,6 +4,8 @@
 #include "myiperf/Protocol.h"
 #include "myiperf/Config.h"
 #include "myiperf/CoroutineSupport.h"
+#include "DataPathEventLog.h"
+#include "TokenBucketPacer.h"
 #include <chrono>
 #include <vector>
 #include <atomic>
@@ -58,10 +60,16 @@ public:
     
 private:
     /**
-     * @brief Creates a packet and returns it as a vector.
-     * @return A vector containing the packet data.
+     * @brief Turns a packet slot that holds the template into the next data packet.
+     *
+     * Only the "Packet N" prefix and the counter and checksum header fields are
+     * written. Under the additive sum the checksum is derived from the template's
+     * sum and the prefix bytes, so the cost is O(digits) rather than O(packetSize).
+     * @param slot packetSize bytes that hold the template or an earlier packet of
+     *        this run. Counters only grow within a run, so the new prefix covers
+     *        the old one.
      */
-    std::vector<char> createPacket();
+    void writePacket(char* slot);
 
     /**
      * @brief Determines whether the generator should continue sending packets.
@@ -72,9 +80,23 @@ private:
     /**
      * @brief Prepares a template for the packets to be sent.
      * This improves efficiency by avoiding repeated construction of the same packet structure.
+     * The template is a complete packet with a payload of '.' only and the
+     * run-invariant header fields set.
      */
     void preparePacketTemplate();
 
+    /**
+     * @brief Fills sendBuffer with batchSize copies of the template, unless it
+     * already holds that many packet slots from this run.
+     */
+    void fillSendBuffer(int batchSize);
+
+    /**
+     * @brief Sends OMIT_END and restarts the byte, packet and time counters;
+     * the counts so far become the omitted window.
+     */
+    Task endOmitWindow();
+
     // Member variables
 
     /**< The network interface for sending data. */
@@ -85,16 +107,37 @@ private:
     std::atomic<long long> totalBytesSent;
     /**< Successfully sent packets count. */
     std::atomic<long long> totalPacketsSent{0};
+    /**< Send calls issued; lower than totalPacketsSent when packets are batched. */
+    std::atomic<long long> totalSendOperations{0};
+    /**< Bytes and packets sent during the --omit window. */
+    std::atomic<long long> omittedBytesSent{0};
+    std::atomic<long long> omittedPacketsSent{0};
 
     /**< The configuration for the current test. */
     Config config;
+    /**< Data packet checksum algorithm, parsed from config when sending starts. */
+    IntegrityAlgorithm integrity = IntegrityAlgorithm::SUM;
     /**< Counter for numbering packets. */
     uint32_t packetCounter;
+    /**< Batch being sent; reused across sends unless it is handed over for zero-copy. */
+    std::vector<char> sendBuffer;
+    /**< One packet with the run-invariant header fields and an all-'.' payload. */
+    std::vector<char> packetTemplate;
+    /**< Additive checksum of the template payload. */
+    uint32_t templatePayloadSum = 0;
+    /**< Per-interval summary of the sends; replaces a log line per send. */
+    DataPathEventLog sendLog;
 
+    /**< Spaces sends to config.getBitrate(); disabled when no rate is set. */
+    TokenBucketPacer pacer;
+    /**< The socket's SO_MAX_PACING_RATE enforces the bitrate; pacer only accounts. */
+    bool kernelPacing = false;
     /**< Timestamp for when the generator was started. */
     std::chrono::steady_clock::time_point m_startTime;
     /**< Timestamp for when the generator should stop. */
     std::chrono::steady_clock::time_point m_endTime;
+    /**< Length of the --omit window; m_startTime is moved to its end. */
+    std::chrono::steady_clock::duration m_omittedDuration{};
 
     TestStats m_LastStats;
 };
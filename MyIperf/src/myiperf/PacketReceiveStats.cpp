@@ -1,64 +1,173 @@
 #include "PacketReceiveStats.h"
 
+#include "PayloadVerifier.h"
 #include "myiperf/Logger.h"
 
-#include <algorithm>
+namespace {
+
+int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Single-writer increment: a relaxed load and store, no locked instruction.
+void bump(std::atomic<long long>& counter, long long amount = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+} // namespace
 
 PacketReceiveStats::PacketReceiveStats() {
     reset();
 }
 
 void PacketReceiveStats::reset() {
-    std::lock_guard<std::mutex> lock(mutex);
-    startTime = std::chrono::steady_clock::now();
-    endTime = startTime;
-    totalBytesReceived = 0;
-    totalPacketsReceived = 0;
-    failedChecksumCount = 0;
-    sequenceErrorCount = 0;
-    contentMismatchCount = 0;
-    expectedPacketCounter = 0;
+    startTimeNs.store(steadyNowNs(), std::memory_order_relaxed);
+    resetEpoch.fetch_add(1, std::memory_order_release);
+}
+
+void PacketReceiveStats::beginWrite() {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const uint64_t requested = resetEpoch.load(std::memory_order_acquire);
+    if (epoch.load(std::memory_order_relaxed) != requested) {
+        epoch.store(requested, std::memory_order_relaxed);
+        endTimeNs.store(0, std::memory_order_relaxed);
+        totalBytesReceived.store(0, std::memory_order_relaxed);
+        totalPacketsReceived.store(0, std::memory_order_relaxed);
+        failedChecksumCount.store(0, std::memory_order_relaxed);
+        sequenceErrorCount.store(0, std::memory_order_relaxed);
+        contentMismatchCount.store(0, std::memory_order_relaxed);
+        payloadsVerified.store(0, std::memory_order_relaxed);
+        expectedPacketCounter = 0;
+    }
+}
+
+void PacketReceiveStats::endWrite() {
+    sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
 }
 
 void PacketReceiveStats::onDataPacket(const ParsedPacket& packet) {
-    std::lock_guard<std::mutex> lock(mutex);
-
-    const std::string expected =
-        buildExpectedPayload(packet.header.packetCounter, packet.header.payloadSize);
-    if (expected.size() == packet.payload.size()
-        && !std::equal(packet.payload.begin(), packet.payload.end(), expected.begin())) {
-        Logger::log("Warning: Payload content mismatch for packet "
-                    + std::to_string(packet.header.packetCounter));
-        contentMismatchCount++;
+    // Verify before publishing anything; the check touches only the packet.
+    const bool contentMismatch = packet.payloadVerified
+        && contentCheck.load(std::memory_order_relaxed)
+        && !PayloadVerifier::matchesExpected(packet.header.packetCounter, packet.payload);
+    if (contentMismatch) {
+        MYIPERF_LOG_WARNING("Payload content mismatch for packet {}", packet.header.packetCounter);
     }
+    const int64_t now = steadyNowNs();
 
-    endTime = std::chrono::steady_clock::now();
-    totalBytesReceived += static_cast<long long>(packet.totalPacketSize);
-    totalPacketsReceived++;
+    beginWrite();
+    if (packet.payloadVerified) {
+        bump(payloadsVerified);
+    }
+    if (contentMismatch) {
+        bump(contentMismatchCount);
+    }
+
+    endTimeNs.store(now, std::memory_order_relaxed);
+    bump(totalBytesReceived, static_cast<long long>(packet.totalPacketSize));
+    bump(totalPacketsReceived);
 
     if (packet.header.packetCounter != expectedPacketCounter) {
-        sequenceErrorCount++;
+        bump(sequenceErrorCount);
         expectedPacketCounter = packet.header.packetCounter;
     }
     expectedPacketCounter++;
+    endWrite();
 }
 
-void PacketReceiveStats::onChecksumFailure() {
-    std::lock_guard<std::mutex> lock(mutex);
-    failedChecksumCount++;
+void PacketReceiveStats::onChecksumFailures(size_t count) {
+    if (count == 0) {
+        return;
+    }
+    beginWrite();
+    bump(failedChecksumCount, static_cast<long long>(count));
+    endWrite();
+}
+
+void PacketReceiveStats::endOmitWindow() {
+    const int64_t now = steadyNowNs();
+    beginWrite();
+    OmittedWindow window;
+    window.epoch = epoch.load(std::memory_order_relaxed);
+    window.duration = static_cast<double>(now - startTimeNs.load(std::memory_order_relaxed)) / 1e9;
+    window.bytes = totalBytesReceived.load(std::memory_order_relaxed);
+    window.packets = totalPacketsReceived.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(omittedMutex);
+        omitted = window;
+    }
+    startTimeNs.store(now, std::memory_order_relaxed);
+    endTimeNs.store(0, std::memory_order_relaxed);
+    totalBytesReceived.store(0, std::memory_order_relaxed);
+    totalPacketsReceived.store(0, std::memory_order_relaxed);
+    endWrite();
+}
+
+void PacketReceiveStats::setContentCheck(bool enabled) {
+    contentCheck.store(enabled, std::memory_order_relaxed);
+}
+
+void PacketReceiveStats::setVerification(VerificationPolicy policy, uint32_t interval) {
+    verification.store(policy, std::memory_order_relaxed);
+    sampleInterval.store(policy == VerificationPolicy::SAMPLED ? interval : 0,
+                         std::memory_order_relaxed);
+}
+
+PacketReceiveStats::Counters PacketReceiveStats::readCounters() const {
+    Counters counters;
+    uint32_t before;
+    uint32_t after;
+    do {
+        before = sequence.load(std::memory_order_acquire);
+        counters.epoch = epoch.load(std::memory_order_relaxed);
+        counters.startTimeNs = startTimeNs.load(std::memory_order_relaxed);
+        counters.endTimeNs = endTimeNs.load(std::memory_order_relaxed);
+        counters.totalBytesReceived = totalBytesReceived.load(std::memory_order_relaxed);
+        counters.totalPacketsReceived = totalPacketsReceived.load(std::memory_order_relaxed);
+        counters.failedChecksumCount = failedChecksumCount.load(std::memory_order_relaxed);
+        counters.sequenceErrorCount = sequenceErrorCount.load(std::memory_order_relaxed);
+        counters.contentMismatchCount = contentMismatchCount.load(std::memory_order_relaxed);
+        counters.payloadsVerified = payloadsVerified.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) != 0 || before != after);
+    return counters;
 }
 
 TestStats PacketReceiveStats::snapshot() const {
-    std::lock_guard<std::mutex> lock(mutex);
+    const uint64_t currentEpoch = resetEpoch.load(std::memory_order_acquire);
+    Counters counters = readCounters();
+    if (counters.epoch != currentEpoch) {
+        // Reset, but the writer has not counted anything since.
+        counters = Counters{};
+        counters.startTimeNs = startTimeNs.load(std::memory_order_relaxed);
+    }
+    const int64_t startNs = counters.startTimeNs;
+
     TestStats stats;
-    stats.totalPacketsReceived = totalPacketsReceived;
-    stats.failedChecksumCount = failedChecksumCount;
-    stats.sequenceErrorCount = sequenceErrorCount;
-    stats.contentMismatchCount = contentMismatchCount;
-    stats.totalBytesReceived = totalBytesReceived;
-
-    if (endTime > startTime) {
-        stats.duration = std::chrono::duration<double>(endTime - startTime).count();
+    stats.totalPacketsReceived = counters.totalPacketsReceived;
+    stats.failedChecksumCount = counters.failedChecksumCount;
+    stats.sequenceErrorCount = counters.sequenceErrorCount;
+    stats.contentMismatchCount = counters.contentMismatchCount;
+    stats.verification = verificationPolicyName(verification.load(std::memory_order_relaxed));
+    stats.verificationSampleInterval =
+        static_cast<int>(sampleInterval.load(std::memory_order_relaxed));
+    stats.payloadsVerified = counters.payloadsVerified;
+    stats.totalBytesReceived = counters.totalBytesReceived;
+    {
+        std::lock_guard<std::mutex> lock(omittedMutex);
+        if (omitted.epoch == counters.epoch && counters.epoch == currentEpoch) {
+            stats.omittedDuration = omitted.duration;
+            stats.omittedBytes = omitted.bytes;
+            stats.omittedPackets = omitted.packets;
+        }
+    }
+
+    if (counters.endTimeNs > startNs) {
+        stats.duration = static_cast<double>(counters.endTimeNs - startNs) / 1e9;
         if (stats.duration > 0) {
             stats.throughputMbps =
                 (static_cast<double>(stats.totalBytesReceived) * 8.0)
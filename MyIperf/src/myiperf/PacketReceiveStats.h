@@ -2,26 +2,99 @@
 
 #include "ParsedPacket.h"
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <mutex>
 
+/**
+ * Receive counters of one stream.
+ *
+ * onDataPacket() and onChecksumFailures() must only be called from the
+ * receiver loop, which is the single writer. The counters are published
+ * through a sequence lock, so snapshot() never blocks the data path: a
+ * reader that overlaps a write simply retries. reset() may be called from
+ * any thread; it opens a new epoch that the writer applies before counting
+ * its next packet, and snapshot() reports zeros until then.
+ *
+ * endOmitWindow() is a writer call too: OMIT_END arrives in-band, so the
+ * boundary falls between the same two packets on both sides.
+ */
 class PacketReceiveStats {
 public:
     PacketReceiveStats();
 
     void reset();
     void onDataPacket(const ParsedPacket& packet);
-    void onChecksumFailure();
+    void onChecksumFailures(size_t count);
+
+    /**
+     * @brief Moves the bytes, packets and time counted so far into the omitted
+     * window and restarts the measurement. Error counters and the expected
+     * packet counter carry on.
+     */
+    void endOmitWindow();
+
+    /**
+     * @brief Enables or disables comparing each payload with buildExpectedPayload().
+     * The comparison only adds value under the additive checksum, which cannot
+     * detect reordered bytes. Survives reset().
+     */
+    void setContentCheck(bool enabled);
+
+    /** @brief Records the verification policy reported with the stats. Survives reset(). */
+    void setVerification(VerificationPolicy policy, uint32_t sampleInterval);
     TestStats snapshot() const;
 
 private:
-    mutable std::mutex mutex;
-    std::chrono::steady_clock::time_point startTime;
-    std::chrono::steady_clock::time_point endTime;
-    long long totalBytesReceived = 0;
-    long long totalPacketsReceived = 0;
-    long long failedChecksumCount = 0;
-    long long sequenceErrorCount = 0;
-    long long contentMismatchCount = 0;
+    /** Counter values copied out of the sequence lock by snapshot(). */
+    struct Counters {
+        uint64_t epoch = 0;
+        int64_t startTimeNs = 0;
+        int64_t endTimeNs = 0;
+        long long totalBytesReceived = 0;
+        long long totalPacketsReceived = 0;
+        long long failedChecksumCount = 0;
+        long long sequenceErrorCount = 0;
+        long long contentMismatchCount = 0;
+        long long payloadsVerified = 0;
+    };
+
+    void beginWrite();
+    void endWrite();
+    Counters readCounters() const;
+
+    // Written by the receiver loop only, between beginWrite() and endWrite().
+    // Atomic so that a racing snapshot() is not a data race; relaxed so the
+    // stores stay plain moves.
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<uint64_t> epoch{0};
+    std::atomic<int64_t> endTimeNs{0};
+    std::atomic<long long> totalBytesReceived{0};
+    std::atomic<long long> totalPacketsReceived{0};
+    std::atomic<long long> failedChecksumCount{0};
+    std::atomic<long long> sequenceErrorCount{0};
+    std::atomic<long long> contentMismatchCount{0};
+    std::atomic<long long> payloadsVerified{0};
     uint32_t expectedPacketCounter = 0;
+
+    // Written by reset(); the writer adopts resetEpoch on its next update.
+    // endOmitWindow() moves startTimeNs inside the sequence lock.
+    std::atomic<uint64_t> resetEpoch{0};
+    std::atomic<int64_t> startTimeNs{0};
+
+    /** The omitted window of one epoch; written once per phase, so a mutex is fine. */
+    struct OmittedWindow {
+        uint64_t epoch = 0;
+        double duration = 0.0;
+        long long bytes = 0;
+        long long packets = 0;
+    };
+    mutable std::mutex omittedMutex;
+    OmittedWindow omitted;
+
+    std::atomic<bool> contentCheck{true};
+    std::atomic<VerificationPolicy> verification{VerificationPolicy::FULL};
+    std::atomic<uint32_t> sampleInterval{0};
 };
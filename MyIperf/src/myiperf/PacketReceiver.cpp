@@ -1,6 +1,7 @@
 #include "PacketReceiver.h"
 
 #include "ControlMessageBus.h"
+#include "myiperf/Config.h"
 #include "myiperf/Logger.h"
 
 namespace {
@@ -21,7 +22,7 @@ PacketReceiver::~PacketReceiver() {
 
 void PacketReceiver::start(ControlMessageBus& messages) {
     if (running) {
-        Logger::log("Info: PacketReceiver is already running.");
+        MYIPERF_LOG_INFO("PacketReceiver is already running.");
         return;
     }
 
@@ -30,7 +31,7 @@ void PacketReceiver::start(ControlMessageBus& messages) {
     dispatcher = std::make_unique<PacketDispatcher>(messages, stats);
     running = true;
 
-    Logger::log("Info: PacketReceiver started.");
+    MYIPERF_LOG_INFO("PacketReceiver started.");
 
     receiverTask = receiverLoop();
     receiverTask.start();
@@ -40,7 +41,7 @@ void PacketReceiver::stop() {
     if (!running.exchange(false)) {
         return;
     }
-    Logger::log("Info: PacketReceiver stopped.");
+    MYIPERF_LOG_INFO("PacketReceiver stopped.");
 }
 
 TestStats PacketReceiver::getStats() const {
@@ -49,32 +50,52 @@ TestStats PacketReceiver::getStats() const {
 
 void PacketReceiver::resetStats() {
     stats.reset();
-    Logger::log("Info: PacketReceiver statistics have been reset.");
+    MYIPERF_LOG_INFO("PacketReceiver statistics have been reset.");
+}
+
+ReceiveChecks ReceiveChecks::fromConfig(const Config& config) {
+    ReceiveChecks checks;
+    parseIntegrityAlgorithm(config.getIntegrity(), checks.integrity);
+    parseVerificationPolicy(config.getVerification(), checks.verification);
+    checks.sampleInterval = static_cast<uint32_t>(config.getVerificationSampleInterval());
+    return checks;
+}
+
+void PacketReceiver::configureChecks(const ReceiveChecks& checks) {
+    parser.setDataIntegrity(checks.integrity);
+    parser.setPayloadVerification(checks.verification, checks.sampleInterval);
+    stats.setContentCheck(checks.integrity == IntegrityAlgorithm::SUM);
+    stats.setVerification(checks.verification, checks.sampleInterval);
 }
 
 Task PacketReceiver::receiverLoop() {
     while (running) {
         try {
-            auto result = co_await networkInterface->receive(packetBufferSize);
+            // Receive straight into the parser's free space; no intermediate buffer.
+            const std::span<char> space = parser.prepare(packetBufferSize).first(packetBufferSize);
+            // Re-registered only when prepare() moved or grew the storage.
+            const std::span<char> storage = parser.storage();
+            if (storage.data() != registeredStorage.data() || storage.size() != registeredStorage.size()) {
+                networkInterface->registerReceiveMemory(storage);
+                registeredStorage = storage;
+            }
+            const size_t bytesReceived = co_await networkInterface->receiveInto(space);
 
-            if (result.bytesReceived == 0) {
-                Logger::log("Warning: 0 bytes received. The connection may have been closed.");
-                auto parsed = parser.drainPackets();
-                for (size_t i = 0; i < parsed.checksumFailures; ++i) {
-                    stats.onChecksumFailure();
-                }
+            if (bytesReceived == 0) {
+                MYIPERF_LOG_WARNING("0 bytes received. The connection may have been closed.");
+                const auto& parsed = parser.drainPackets();
+                stats.onChecksumFailures(parsed.checksumFailures);
                 if (dispatcher) {
                     dispatcher->dispatch(parsed.packets);
+                    dispatcher->flush();
                 }
                 stop();
                 break;
             }
 
-            parser.append(result.data, result.bytesReceived);
-            auto parsed = parser.drainPackets();
-            for (size_t i = 0; i < parsed.checksumFailures; ++i) {
-                stats.onChecksumFailure();
-            }
+            parser.commit(bytesReceived);
+            const auto& parsed = parser.drainPackets();
+            stats.onChecksumFailures(parsed.checksumFailures);
             if (dispatcher) {
                 dispatcher->dispatch(parsed.packets);
             }
@@ -84,4 +105,6 @@ Task PacketReceiver::receiverLoop() {
             break;
         }
     }
+    networkInterface->registerReceiveMemory({});
+    registeredStorage = {};
 }
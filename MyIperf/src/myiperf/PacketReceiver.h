@@ -9,8 +9,23 @@
 #include <atomic>
 #include <memory>
 
+class Config;
 class ControlMessageBus;
 
+/**
+ * @struct ReceiveChecks
+ * @brief Payload checks a receiver applies to DATA_PACKETs, as agreed in the handshake.
+ */
+struct ReceiveChecks {
+    IntegrityAlgorithm integrity = IntegrityAlgorithm::SUM;
+    VerificationPolicy verification = VerificationPolicy::FULL;
+    /** Every Nth packet is checked under VerificationPolicy::SAMPLED. */
+    uint32_t sampleInterval = 1;
+
+    /** @brief Reads the negotiated integrity and verification settings of a config. */
+    static ReceiveChecks fromConfig(const Config& config);
+};
+
 /**
  * @class PacketReceiver
  * @brief Owns the receive coroutine lifecycle.
@@ -51,6 +66,14 @@ public:
      */
     void resetStats();
 
+    /**
+     * @brief Applies the negotiated integrity algorithm and verification policy.
+     * With a strong algorithm (CRC32C, XXH3) the checksum already detects
+     * corrupted or reordered payload bytes, so the per-packet comparison
+     * against the expected payload is skipped.
+     */
+    void configureChecks(const ReceiveChecks& checks);
+
 private:
     Task receiverLoop();
 
@@ -58,6 +81,8 @@ private:
     std::atomic<bool> running;
     size_t packetBufferSize;
     PacketStreamParser parser;
+    /** Parser storage last passed to NetworkInterface::registerReceiveMemory(). */
+    std::span<char> registeredStorage;
     PacketReceiveStats stats;
     std::unique_ptr<PacketDispatcher> dispatcher;
     Task receiverTask{nullptr};
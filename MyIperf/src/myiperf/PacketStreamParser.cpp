@@ -2,6 +2,7 @@
 
 #include "myiperf/Logger.h"
 
+#include <algorithm>
 #include <cstring>
 #include <thread>
 
@@ -15,49 +16,71 @@ PacketStreamParser::PacketStreamParser(size_t maxPayloadSize)
     : maxPayloadSize(maxPayloadSize) {}
 
 void PacketStreamParser::reset() {
-    buffer.clear();
+    head = 0;
+    tail = 0;
+    result.packets.clear();
+    result.checksumFailures = 0;
     consecutiveFailures = 0;
 }
 
-void PacketStreamParser::append(const std::vector<char>& data,
-                                size_t bytesReceived) {
-    buffer.insert(buffer.end(), data.begin(), data.begin() + bytesReceived);
+void PacketStreamParser::setDataIntegrity(IntegrityAlgorithm algorithm) {
+    dataIntegrity.store(algorithm, std::memory_order_relaxed);
 }
 
-PacketParseResult PacketStreamParser::drainPackets() {
-    PacketParseResult result;
+void PacketStreamParser::setPayloadVerification(VerificationPolicy policy, uint32_t interval) {
+    sampleInterval.store(interval > 0 ? interval : 1, std::memory_order_relaxed);
+    verification.store(policy, std::memory_order_relaxed);
+}
 
-    while (!buffer.empty()) {
-        if (buffer.size() < sizeof(PacketHeader)) {
-            break;
+std::span<char> PacketStreamParser::prepare(size_t minBytes) {
+    if (buffer.size() - tail < minBytes) {
+        // Compact: move the unparsed remainder, at most one partial packet in a
+        // steady stream, to the front. Storage only grows, so it is reused.
+        if (head > 0) {
+            std::memmove(buffer.data(), buffer.data() + head, tail - head);
+            tail -= head;
+            head = 0;
+        }
+        if (buffer.size() - tail < minBytes) {
+            buffer.resize(tail + minBytes);
         }
+    }
+    return std::span<char>(buffer.data() + tail, buffer.size() - tail);
+}
 
+void PacketStreamParser::commit(size_t bytes) {
+    tail += std::min(bytes, buffer.size() - tail);
+}
+
+const PacketParseResult& PacketStreamParser::drainPackets() {
+    result.packets.clear();
+    result.checksumFailures = 0;
+    const IntegrityAlgorithm integrity = dataIntegrity.load(std::memory_order_relaxed);
+    const VerificationPolicy policy = verification.load(std::memory_order_relaxed);
+    const uint32_t interval = sampleInterval.load(std::memory_order_relaxed);
+
+    while (tail - head >= sizeof(PacketHeader)) {
         PacketHeader header{};
-        std::memcpy(&header, buffer.data(), sizeof(PacketHeader));
+        std::memcpy(&header, buffer.data() + head, sizeof(PacketHeader));
 
         if (header.payloadSize > maxPayloadSize) {
-            Logger::log("Error: Invalid payload size in header. Clearing buffer to resynchronize. "
-                        + std::to_string(header.payloadSize)
-                        + " bytes exceeds maximum allowed "
-                        + std::to_string(maxPayloadSize));
-            buffer.clear();
+            MYIPERF_LOG_ERROR("Invalid payload size in header. Clearing buffer to resynchronize. "
+                              "{} bytes exceeds maximum allowed {}", header.payloadSize, maxPayloadSize);
+            head = tail;
             break;
         }
 
         const size_t totalPacketSize = sizeof(PacketHeader) + header.payloadSize;
-        if (buffer.size() < totalPacketSize) {
-#ifdef DEBUG_LOG
-            Logger::log("Debug: PacketStreamParser incomplete packet, have="
-                        + std::to_string(buffer.size()) + ", need="
-                        + std::to_string(totalPacketSize));
-#endif
+        if (tail - head < totalPacketSize) {
+            MYIPERF_LOG_DEBUG("PacketStreamParser incomplete packet, have={}, need={}",
+                              tail - head, totalPacketSize);
             break;
         }
 
-        const char* payload = buffer.data() + sizeof(PacketHeader);
+        const char* payload = buffer.data() + head + sizeof(PacketHeader);
         if (header.startCode != PROTOCOL_START_CODE) {
-            Logger::log("Error: Invalid start code detected. Discarding one byte to find the next packet.");
-            buffer.erase(buffer.begin());
+            MYIPERF_LOG_ERROR("Invalid start code detected. Discarding one byte to find the next packet.");
+            head++;
             consecutiveFailures++;
             if (consecutiveFailures >= MAX_CONSECUTIVE_FAILURES) {
                 std::this_thread::yield();
@@ -66,15 +89,20 @@ PacketParseResult PacketStreamParser::drainPackets() {
             continue;
         }
 
-        if (!verifyPacket(header, payload)) {
-            Logger::log("Error: Checksum validation failed. Discarding one byte to find the next packet.");
+        // Control packets are always verified; the policy only thins out data packets.
+        bool payloadVerified = true;
+        if (header.messageType == MessageType::DATA_PACKET) {
+            payloadVerified = policy == VerificationPolicy::FULL
+                || (policy == VerificationPolicy::SAMPLED && header.packetCounter % interval == 0);
+        }
+
+        if (payloadVerified && !verifyPacket(header, payload, integrity)) {
+            MYIPERF_LOG_ERROR("Checksum validation failed. Discarding one byte to find the next packet.");
             if (header.messageType != MessageType::DATA_PACKET) {
-                Logger::log("Error: Checksum failure for control message type "
-                            + std::to_string(static_cast<int>(header.messageType))
-                            + " (expected size " + std::to_string(totalPacketSize)
-                            + ")");
+                MYIPERF_LOG_ERROR("Checksum failure for control message type {} (expected size {})",
+                                  static_cast<int>(header.messageType), totalPacketSize);
             }
-            buffer.erase(buffer.begin());
+            head++;
             result.checksumFailures++;
             consecutiveFailures++;
             if (consecutiveFailures >= MAX_CONSECUTIVE_FAILURES) {
@@ -87,12 +115,18 @@ PacketParseResult PacketStreamParser::drainPackets() {
         consecutiveFailures = 0;
         ParsedPacket packet;
         packet.header = header;
-        packet.payload.assign(payload, payload + header.payloadSize);
+        packet.payload = std::span<const char>(payload, header.payloadSize);
         packet.totalPacketSize = totalPacketSize;
-        result.packets.push_back(std::move(packet));
+        packet.payloadVerified = payloadVerified;
+        result.packets.push_back(packet);
 
-        buffer.erase(buffer.begin(), buffer.begin() + totalPacketSize);
+        head += totalPacketSize;
     }
 
+    // Everything parsed: start over at the front so the next receive needs no compaction.
+    if (head == tail) {
+        head = 0;
+        tail = 0;
+    }
     return result;
 }
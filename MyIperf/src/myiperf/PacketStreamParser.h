@@ -2,10 +2,13 @@
 
 #include "ParsedPacket.h"
 
+#include <atomic>
 #include <cstddef>
+#include <span>
 #include <vector>
 
 struct PacketParseResult {
+    /** Views into the parser's buffer; see ParsedPacket for their lifetime. */
     std::vector<ParsedPacket> packets;
     size_t checksumFailures = 0;
 };
@@ -15,11 +18,53 @@ public:
     explicit PacketStreamParser(size_t maxPayloadSize);
 
     void reset();
-    void append(const std::vector<char>& data, size_t bytesReceived);
-    PacketParseResult drainPackets();
+
+    /**
+     * @brief Returns writable space of at least minBytes behind the unparsed data,
+     * so a receive can land in the parser without an intermediate copy.
+     * The span is valid until the next prepare(), commit(), drainPackets() or reset().
+     */
+    std::span<char> prepare(size_t minBytes);
+
+    /**
+     * @brief The whole storage prepare() hands out spans of. It moves or grows
+     * only when prepare() needs more room.
+     */
+    std::span<char> storage() { return buffer; }
+
+    /** @brief Marks the first bytes of the last prepare() span as received data. */
+    void commit(size_t bytes);
+
+    /**
+     * @brief Parses every complete packet received so far.
+     * Parsing only advances a read offset; nothing is copied or erased. The
+     * returned result is reused by the next call.
+     */
+    const PacketParseResult& drainPackets();
+
+    /**
+     * @brief Sets the checksum algorithm DATA_PACKETs are verified with.
+     * Control packets are always verified with IntegrityAlgorithm::SUM. The
+     * setting survives reset() and may be changed while receiving.
+     */
+    void setDataIntegrity(IntegrityAlgorithm algorithm);
+
+    /**
+     * @brief Sets which DATA_PACKET payloads are checksummed. Skipped packets are
+     * returned with ParsedPacket::payloadVerified false. Survives reset().
+     * @param sampleInterval N for VerificationPolicy::SAMPLED.
+     */
+    void setPayloadVerification(VerificationPolicy policy, uint32_t sampleInterval);
 
 private:
     size_t maxPayloadSize;
+    /** Storage. Bytes [head, tail) are received but not yet parsed. */
     std::vector<char> buffer;
+    size_t head = 0;
+    size_t tail = 0;
+    PacketParseResult result;
     int consecutiveFailures = 0;
+    std::atomic<IntegrityAlgorithm> dataIntegrity{IntegrityAlgorithm::SUM};
+    std::atomic<VerificationPolicy> verification{VerificationPolicy::FULL};
+    std::atomic<uint32_t> sampleInterval{1};
 };
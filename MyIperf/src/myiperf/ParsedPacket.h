@@ -3,10 +3,15 @@
 #include "myiperf/Protocol.h"
 
 #include <cstddef>
-#include <vector>
+#include <span>
 
+// A parsed packet is a view into PacketStreamParser's buffer. The payload is
+// not copied; it stays valid until the parser is next prepared, committed,
+// drained or reset. Consumers that keep a payload (ControlMessageBus) copy it.
 struct ParsedPacket {
     PacketHeader header{};
-    std::vector<char> payload;
+    std::span<const char> payload;
     size_t totalPacketSize = 0;
+    /** False if the verification policy skipped the payload checksum of this DATA_PACKET. */
+    bool payloadVerified = true;
 };
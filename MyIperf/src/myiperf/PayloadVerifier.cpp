@@ -0,0 +1,114 @@
+#include "PayloadVerifier.h"
+
+#include "CpuFeatures.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace PayloadVerifier {
+
+namespace {
+
+constexpr char kFill = '.';
+
+using FillKernel = bool (*)(const char* data, size_t size);
+
+bool isFillScalar(const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        if (data[i] != kFill) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef MYIPERF_X86_64
+
+// The kernels OR together the XOR of every block with the fill pattern and test
+// the result once at the end. Mismatches are rare, so an early exit per block
+// would only add branches to the common path.
+
+MYIPERF_TARGET("sse2")
+bool isFillSse2(const char* data, size_t size) {
+    const __m128i fill = _mm_set1_epi8(kFill);
+    __m128i diff = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        diff = _mm_or_si128(diff, _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), fill));
+    }
+    const bool blocksMatch = _mm_movemask_epi8(_mm_cmpeq_epi8(diff, _mm_setzero_si128())) == 0xFFFF;
+    return blocksMatch && isFillScalar(data + i, size - i);
+}
+
+MYIPERF_TARGET("avx2")
+bool isFillAvx2(const char* data, size_t size) {
+    const __m256i fill = _mm256_set1_epi8(kFill);
+    __m256i diff0 = _mm256_setzero_si256();
+    __m256i diff1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        diff0 = _mm256_or_si256(diff0, _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), fill));
+        diff1 = _mm256_or_si256(diff1, _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32)), fill));
+    }
+    if (i + 32 <= size) {
+        diff0 = _mm256_or_si256(diff0, _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), fill));
+        i += 32;
+    }
+    const __m256i diff = _mm256_or_si256(diff0, diff1);
+    return _mm256_testz_si256(diff, diff) && isFillScalar(data + i, size - i);
+}
+
+MYIPERF_TARGET("avx512f,avx512bw,bmi2")
+bool isFillAvx512(const char* data, size_t size) {
+    const __m512i fill = _mm512_set1_epi8(kFill);
+    __mmask64 diff = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        diff |= _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(data + i), fill);
+    }
+    if (i < size) {
+        // Masked-off bytes are neither read nor compared.
+        const __mmask64 tail = _bzhi_u64(~0ULL, static_cast<unsigned>(size - i));
+        diff |= _mm512_mask_cmpneq_epi8_mask(tail, _mm512_maskz_loadu_epi8(tail, data + i), fill);
+    }
+    return diff == 0;
+}
+
+#endif // MYIPERF_X86_64
+
+FillKernel selectFillKernel() {
+#ifdef MYIPERF_X86_64
+    const CpuFeatures& features = cpuFeatures();
+    if (features.avx512bw) {
+        return &isFillAvx512;
+    }
+    if (features.avx2) {
+        return &isFillAvx2;
+    }
+    if (features.sse2) {
+        return &isFillSse2;
+    }
+#endif
+    return &isFillScalar;
+}
+
+} // namespace
+
+bool isFill(const char* data, size_t size) {
+    static const FillKernel kernel = selectFillKernel();
+    return kernel(data, size);
+}
+
+bool matchesExpected(uint32_t packetCounter, std::span<const char> payload) {
+    // Same text as buildExpectedPayload(): "Packet N", truncated to the payload size.
+    char prefix[32] = "Packet ";
+    const auto digits = std::to_chars(prefix + 7, prefix + sizeof(prefix), packetCounter);
+    const size_t prefixSize = std::min(static_cast<size_t>(digits.ptr - prefix), payload.size());
+    if (std::memcmp(payload.data(), prefix, prefixSize) != 0) {
+        return false;
+    }
+    return isFill(payload.data() + prefixSize, payload.size() - prefixSize);
+}
+
+} // namespace PayloadVerifier
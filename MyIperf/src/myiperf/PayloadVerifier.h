@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Checks received payloads against buildExpectedPayload() without building it.
+ *
+ * An expected payload is "Packet N" followed by '.' fill. The prefix is
+ * formatted on the stack and compared directly; the fill is compared in place
+ * with the widest SIMD kernel the CPU supports (SSE2, AVX2 or AVX-512BW). No
+ * allocation takes place and the functions are safe to call from any thread.
+ */
+namespace PayloadVerifier {
+
+/** @brief True if payload equals buildExpectedPayload(packetCounter, payload.size()). */
+bool matchesExpected(uint32_t packetCounter, std::span<const char> payload);
+
+/** @brief True if every byte of data is the '.' fill character. */
+bool isFill(const char* data, size_t size);
+
+} // namespace PayloadVerifier
@@ -0,0 +1,35 @@
+#include "ReceiveBufferPool.h"
+
+#include <algorithm>
+
+ReceiveBufferPool::ReceiveBufferPool(size_t bufferSize, size_t maxIdle)
+    : bufferSize(bufferSize), maxIdle(maxIdle) {
+    // Reserve the idle list up front so release() never allocates either.
+    idle.reserve(maxIdle);
+}
+
+std::vector<char> ReceiveBufferPool::acquire(size_t minSize) {
+    if (!idle.empty() && idle.back().size() >= minSize) {
+        std::vector<char> buffer = std::move(idle.back());
+        idle.pop_back();
+        hitCount.fetch_add(1, std::memory_order_relaxed);
+        return buffer;
+    }
+    missCount.fetch_add(1, std::memory_order_relaxed);
+    return std::vector<char>(std::max(bufferSize, minSize));
+}
+
+void ReceiveBufferPool::release(std::vector<char> buffer) {
+    if (buffer.size() < bufferSize || idle.size() >= maxIdle) {
+        return;
+    }
+    idle.push_back(std::move(buffer));
+}
+
+long long ReceiveBufferPool::hits() const {
+    return hitCount.load(std::memory_order_relaxed);
+}
+
+long long ReceiveBufferPool::misses() const {
+    return missCount.load(std::memory_order_relaxed);
+}
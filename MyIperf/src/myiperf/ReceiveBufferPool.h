@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class ReceiveBufferPool
+ * @brief Recycles fixed-size receive buffers so steady-state receives do not allocate.
+ *
+ * A backend acquires a buffer before reading from the socket, lends it to the
+ * receive callback and releases it afterwards. acquire() counts a hit when an
+ * idle buffer is reused and a miss when it has to allocate; a run whose miss
+ * count stays at a handful did no per-receive heap allocation.
+ *
+ * acquire() and release() are meant for the backend's I/O thread and are not
+ * synchronized. The counters may be read from any thread.
+ */
+class ReceiveBufferPool {
+public:
+    /**
+     * @param bufferSize Size of the buffers the pool hands out.
+     * @param maxIdle Number of released buffers kept for reuse.
+     */
+    ReceiveBufferPool(size_t bufferSize, size_t maxIdle);
+
+    /**
+     * @brief Returns a buffer of at least minSize bytes.
+     * The contents are unspecified; only the bytes a receive writes are meaningful.
+     */
+    std::vector<char> acquire(size_t minSize);
+
+    /**
+     * @brief Hands a buffer back for reuse. Buffers smaller than the pool size,
+     * or beyond maxIdle idle buffers, are freed instead.
+     */
+    void release(std::vector<char> buffer);
+
+    /** @brief Number of acquire() calls served from an idle buffer. */
+    long long hits() const;
+
+    /** @brief Number of acquire() calls that allocated a new buffer. */
+    long long misses() const;
+
+private:
+    size_t bufferSize;
+    size_t maxIdle;
+    std::vector<std::vector<char>> idle;
+    std::atomic<long long> hitCount{0};
+    std::atomic<long long> missCount{0};
+};
@@ -51,19 +51,56 @@ Task ServerTestSession::acceptAndReceiveConfig() {
   Config receivedConfig =
       Config::fromJson(ControlProtocol::parseJsonPayload(configMessage.payload));
   receivedConfig.setMode(Config::TestMode::SERVER);
+  receivedConfig.setNetworkBackend(context.config.getNetworkBackend());
   context.config = receivedConfig;
   Logger::log("Info: Received Config.");
 
-  co_await context.control.send(MessageType::CONFIG_ACK);
+  // Clients that predate integrity negotiation send no algorithm and get the
+  // sum; clients that predate verification policies get full verification.
+  const ReceiveChecks checks = ReceiveChecks::fromConfig(context.config);
+  context.receiver.configureChecks(checks);
+  Logger::log(std::string("Info: Data integrity: ") +
+              integrityAlgorithmName(checks.integrity));
+  Logger::log("Info: Payload verification: " +
+              describeVerification(verificationPolicyName(checks.verification),
+                                   static_cast<int>(checks.sampleInterval)));
+
+  // Extra data streams must be listening before the client sees CONFIG_ACK.
+  context.streams.create(context.config.getParallelStreams(),
+                         context.config.getNetworkBackend(), checks);
+  if (!context.streams.prepareServers(context.config.getTargetIP(),
+                                      context.config.getPort())) {
+    fail("Error: Server init failed for parallel data streams");
+  }
+
+  // The client starts sending as soon as CONFIG_ACK arrives and its data
+  // streams connect, so counters must be clean before the ACK goes out.
+  context.receiver.resetStats();
+
+  // Confirming the algorithm lets the client tell this server apart from older
+  // ones, which ack with an empty payload and only know the sum. Confirming
+  // the omit window tells the client that this server handles OMIT_END.
+  nlohmann::json ack;
+  ack["integrity"] = integrityAlgorithmName(checks.integrity);
+  ack["omit"] = context.config.getOmitSeconds();
+  const std::string ackText = ack.dump();
+  co_await context.control.send(
+      MessageType::CONFIG_ACK,
+      std::vector<char>(ackText.begin(), ackText.end()));
   Logger::log("CONTROL: Sent CONFIG_ACK.");
+
+  if (context.streams.extraStreamCount() > 0) {
+    co_await context.streams.acceptAll();
+  }
 }
 
 Task ServerTestSession::runClientToServerPhase() {
   context.transitionTo(TestController::State::RUNNING_TEST);
-  context.receiver.resetStats();
 
-  co_await context.control.waitFor(MessageType::TEST_FIN);
+  co_await context.control.waitFor(
+      MessageType::TEST_FIN, ControlProtocol::dataPhaseTimeoutMs(context.config));
   Logger::log("CONTROL: Received TEST_FIN from client for Phase 1.");
+  co_await context.streams.waitForStreamFin();
 
   context.transitionTo(TestController::State::FINISHING);
   co_await context.control.send(MessageType::TEST_FIN);
@@ -74,7 +111,8 @@ Task ServerTestSession::runClientToServerPhase() {
   Logger::log("CONTROL: Received STATS_EXCHANGE for Phase 1.");
   context.clientStatsPhase1 =
       ControlProtocol::parseStatsPayload(statsMessage.payload);
-  context.serverStatsPhase1 = context.receiver.getStats();
+  context.serverStatsPhase1 =
+      context.streams.combineReceiverStats(context.receiver.getStats());
 
   ControlProtocol::logPhaseSummary("Test Phase 1 Summary",
                                    "Client-side (sent)",
@@ -97,7 +135,7 @@ Task ServerTestSession::runServerToClientPhase() {
   context.transitionTo(TestController::State::RUNNING_SERVER_TEST);
   context.generator.resetStats();
 
-  co_await context.generator.sendPackets(context.config);
+  co_await context.streams.sendPackets(context.generator, context.config);
   Logger::log("Info: Server generator finished.");
 
   context.transitionTo(TestController::State::SERVER_TEST_FINISHING);
@@ -109,7 +147,8 @@ Task ServerTestSession::runServerToClientPhase() {
   Logger::log("CONTROL: Received STATS_EXCHANGE for Phase 2.");
   context.clientStatsPhase2 =
       ControlProtocol::parseStatsPayload(statsMessage.payload);
-  context.serverStatsPhase2 = context.generator.getStats();
+  context.serverStatsPhase2 =
+      context.streams.combineGeneratorStats(context.generator.getStats());
 
   ControlProtocol::logPhaseSummary("Test Phase 2 Summary",
                                    "Server-side (sent)",
@@ -1,9 +1,11 @@
 #include "myiperf/TestController.h"
 
+#include "Checksum.h"
 #include "ClientTestSession.h"
 #include "ControlChannel.h"
 #include "ControlMessageBus.h"
 #include "ControlProtocol.h"
+#include "DataStreamSet.h"
 #include "NetworkInterfaceFactory.h"
 #include "PacketGenerator.h"
 #include "PacketReceiver.h"
@@ -186,29 +188,49 @@ std::string combineReasons(const std::string& left, const std::string& right) {
 }
 
 std::string validateReceiverStats(const TestStats& receiver,
+                                  const TestStats& sender,
                                   const Config& config) {
   std::string reason;
-  const long long expectedPackets = config.getNumPackets();
-  const long long expectedBytes =
+  long long expectedPackets =
+      static_cast<long long>(config.getNumPackets()) *
+      config.getParallelStreams();
+  long long expectedBytes =
       expectedPackets > 0
           ? static_cast<long long>(config.getPacketSize()) * expectedPackets
           : 0;
-
-  if (expectedPackets > 0 &&
-      receiver.totalPacketsReceived != expectedPackets) {
+  if (config.getTestDuration() > 0.0) {
+    // A timed phase may end before numPackets; the receiver must then get
+    // exactly what the sender reports.
+    expectedPackets = sender.totalPacketsSent + sender.omittedPackets;
+    expectedBytes = sender.totalBytesSent + sender.omittedBytes;
+  }
+  // The --omit window is part of the transfer, just not of the measurement.
+  const long long receivedPackets =
+      receiver.totalPacketsReceived + receiver.omittedPackets;
+  const long long receivedBytes =
+      receiver.totalBytesReceived + receiver.omittedBytes;
+
+  if (expectedPackets > 0 && receivedPackets != expectedPackets) {
     reason = combineReasons(reason,
                             "Packet count mismatch (Rx: " +
-                                std::to_string(receiver.totalPacketsReceived) +
+                                std::to_string(receivedPackets) +
                                 ", Exp: " + std::to_string(expectedPackets) +
                                 ")");
   }
-  if (expectedBytes > 0 && receiver.totalBytesReceived != expectedBytes) {
+  if (expectedBytes > 0 && receivedBytes != expectedBytes) {
     reason = combineReasons(reason,
                             "Byte count mismatch (Rx: " +
-                                std::to_string(receiver.totalBytesReceived) +
+                                std::to_string(receivedBytes) +
                                 ", Exp: " + std::to_string(expectedBytes) +
                                 ")");
   }
+  if (receiver.omittedPackets != sender.omittedPackets) {
+    reason = combineReasons(reason,
+                            "Omit boundary mismatch (Rx: " +
+                                std::to_string(receiver.omittedPackets) +
+                                ", Tx: " +
+                                std::to_string(sender.omittedPackets) + ")");
+  }
   if (receiver.failedChecksumCount > 0) {
     reason = combineReasons(reason,
                             "Checksum errors detected (" +
@@ -239,6 +261,7 @@ TestController::TestController()
       controlMessages(std::make_unique<ControlMessageBus>()),
       controlChannel(
           std::make_unique<ControlChannel>(*networkInterface, *controlMessages)),
+      dataStreams(std::make_unique<DataStreamSet>()),
       resultEventSink(std::make_unique<ResultEventSink>()) {
   reset();
 }
@@ -247,6 +270,21 @@ TestController::~TestController() {
   stopTest();
 }
 
+void TestController::rebuildNetworkComponents(const std::string& backend) {
+  // Components hold references to the interface, so tear down in reverse order.
+  controlChannel.reset();
+  packetReceiver.reset();
+  packetGenerator.reset();
+  networkInterface.reset();
+
+  networkInterface = createNetworkInterface(backend);
+  packetGenerator = std::make_unique<PacketGenerator>(networkInterface.get());
+  packetReceiver = std::make_unique<PacketReceiver>(networkInterface.get());
+  controlChannel =
+      std::make_unique<ControlChannel>(*networkInterface, *controlMessages);
+  m_networkBackend = backend;
+}
+
 void TestController::reset() {
   if (resultEventSink) {
     resultEventSink->stop();
@@ -297,6 +335,9 @@ void TestController::startTest(const Config& config) {
 }
 
 void TestController::startTest(const Config& config, const RunOptions& options) {
+  if (config.getNetworkBackend() != m_networkBackend) {
+    rebuildNetworkComponents(config.getNetworkBackend());
+  }
   reset();
   currentConfig = config;
   currentRunOptions = options;
@@ -315,6 +356,8 @@ void TestController::startTest(const Config& config, const RunOptions& options)
   logMessage += " mode.";
   Logger::log(logMessage);
   Logger::log("Info: Test run ID: " + currentRunOptions.runId);
+  Logger::log(std::string("Info: Checksum kernel: ") +
+              Checksum::selectedKernel().name);
 
   if (resultEventSink) {
     resultEventSink->start(currentRunOptions.resultPipe);
@@ -352,10 +395,9 @@ bool TestController::completedSuccessfully() const {
 }
 
 void TestController::stopTest() {
-  Logger::log("Debug: TestController::stopTest() called.");
+  MYIPERF_LOG_DEBUG("TestController::stopTest() called.");
   if (m_stopped.exchange(true)) {
-    Logger::log(
-        "Debug: TestController::stopTest() already stopped, returning.");
+    MYIPERF_LOG_DEBUG("TestController::stopTest() already stopped, returning.");
     return;
   }
   Logger::log("Info: Stopping the test components.");
@@ -364,16 +406,17 @@ void TestController::stopTest() {
     controlChannel->cancelAll();
   }
 
-  Logger::log("Debug: Calling packetGenerator->stop().");
+  MYIPERF_LOG_DEBUG("Calling packetGenerator->stop().");
   packetGenerator->stop();
-  Logger::log("Debug: packetGenerator->stop() completed.");
-  Logger::log("Debug: Calling packetReceiver->stop().");
+  MYIPERF_LOG_DEBUG("packetGenerator->stop() completed.");
+  MYIPERF_LOG_DEBUG("Calling packetReceiver->stop().");
   packetReceiver->stop();
-  Logger::log("Debug: packetReceiver->stop() completed.");
-  Logger::log("Debug: Calling networkInterface->close().");
+  MYIPERF_LOG_DEBUG("packetReceiver->stop() completed.");
+  MYIPERF_LOG_DEBUG("Calling networkInterface->close().");
   networkInterface->close();
-  Logger::log("Debug: networkInterface->close() completed.");
-  Logger::log("Debug: TestController::stopTest() finished.");
+  MYIPERF_LOG_DEBUG("networkInterface->close() completed.");
+  dataStreams->close();
+  MYIPERF_LOG_DEBUG("TestController::stopTest() finished.");
 
   if (m_testStarted.load(std::memory_order_acquire)) {
     finalizeResultOnce("Test stopped before completion");
@@ -400,6 +443,7 @@ Task TestController::runTestCoroutine() {
       *packetGenerator,
       *packetReceiver,
       *controlChannel,
+      *dataStreams,
       m_clientStatsPhase1,
       m_serverStatsPhase1,
       m_clientStatsPhase2,
@@ -448,6 +492,10 @@ TestController::buildCurrentResult(const std::string& failureReason) const {
   result.finishedAt = nowIsoString();
   result.finalState = stateToString(currentState.load());
   result.config = currentConfig;
+  result.integrity = currentConfig.getIntegrity();
+  result.verification =
+      describeVerification(currentConfig.getVerification(),
+                           currentConfig.getVerificationSampleInterval());
   result.resultExportWarning = m_resultExportWarning;
 
   result.phase1.phaseName = "client_to_server";
@@ -456,7 +504,8 @@ TestController::buildCurrentResult(const std::string& failureReason) const {
   result.phase1.senderStats = m_clientStatsPhase1;
   result.phase1.receiverStats = m_serverStatsPhase1;
   result.phase1.failureReason =
-      validateReceiverStats(result.phase1.receiverStats, currentConfig);
+      validateReceiverStats(result.phase1.receiverStats,
+                            result.phase1.senderStats, currentConfig);
   result.phase1.success = result.phase1.failureReason.empty();
 
   result.phase2.phaseName = "server_to_client";
@@ -465,9 +514,13 @@ TestController::buildCurrentResult(const std::string& failureReason) const {
   result.phase2.senderStats = m_serverStatsPhase2;
   result.phase2.receiverStats = m_clientStatsPhase2;
   result.phase2.failureReason =
-      validateReceiverStats(result.phase2.receiverStats, currentConfig);
+      validateReceiverStats(result.phase2.receiverStats,
+                            result.phase2.senderStats, currentConfig);
   result.phase2.success = result.phase2.failureReason.empty();
 
+  result.ioStats = networkInterface->getIoStats();
+  result.ioStats += dataStreams->ioStats();
+
   const bool finished = currentState.load() == State::FINISHED;
   result.success = finished && result.phase1.success && result.phase2.success;
   if (!failureReason.empty()) {
@@ -516,6 +569,36 @@ std::string TestController::exportResult(const TestRunResult& result) {
 void TestController::finalizeResultOnce(const std::string& failureReason) {
   if (!m_resultFinalized.exchange(true, std::memory_order_acq_rel)) {
     TestRunResult result = buildCurrentResult(failureReason);
+    const NetworkIoStats& io = result.ioStats;
+    Logger::log("Info: Network I/O syscalls (" + io.backend +
+                "): total=" + std::to_string(io.totalSyscalls()) +
+                " send=" + std::to_string(io.sendCalls) +
+                " recv=" + std::to_string(io.recvCalls) +
+                " wait=" + std::to_string(io.waitCalls) +
+                " control=" + std::to_string(io.controlCalls) +
+                " wakeup=" + std::to_string(io.wakeupCalls));
+    if (io.recvBufferHits + io.recvBufferMisses + io.recvDirect > 0) {
+      Logger::log("Info: Receive buffers: hits=" + std::to_string(io.recvBufferHits) +
+                  " misses=" + std::to_string(io.recvBufferMisses) +
+                  " direct=" + std::to_string(io.recvDirect));
+    }
+    if (io.zeroCopySends > 0) {
+      Logger::log("Info: Zero-copy sends: " + std::to_string(io.zeroCopySends) +
+                  " (completed=" + std::to_string(io.zeroCopyCompleted) +
+                  ", copied=" + std::to_string(io.zeroCopyCopied) + ")");
+    }
+    const TestPhaseResult& sendPhase =
+        result.role == result.phase1.senderRole ? result.phase1 : result.phase2;
+    const long long packetsSent = sendPhase.senderStats.totalPacketsSent;
+    if (packetsSent > 0 && io.sendCalls > 0) {
+      std::ostringstream ratio;
+      ratio << std::fixed << std::setprecision(2)
+            << static_cast<double>(packetsSent) / static_cast<double>(io.sendCalls);
+      Logger::log("Info: Data packets per send syscall: " + ratio.str() +
+                  " (packets=" + std::to_string(packetsSent) +
+                  ", send calls=" + std::to_string(io.sendCalls) +
+                  ", batch=" + std::to_string(currentConfig.getSendBatchSize()) + ")");
+    }
     std::string exportWarning = exportResult(result);
     if (!exportWarning.empty()) {
       result.resultExportWarning = exportWarning;
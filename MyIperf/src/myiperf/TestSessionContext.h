@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ControlChannel.h"
+#include "DataStreamSet.h"
 #include "PacketGenerator.h"
 #include "PacketReceiver.h"
 #include "myiperf/Config.h"
@@ -15,6 +16,7 @@ struct TestSessionContext {
   PacketGenerator& generator;
   PacketReceiver& receiver;
   ControlChannel& control;
+  DataStreamSet& streams;
   TestStats& clientStatsPhase1;
   TestStats& serverStatsPhase1;
   TestStats& clientStatsPhase2;
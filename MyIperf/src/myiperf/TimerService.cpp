@@ -0,0 +1,82 @@
+#include "myiperf/TimerService.h"
+
+TimerService& TimerService::shared() {
+    static TimerService instance;
+    return instance;
+}
+
+TimerService::TimerService() = default;
+
+TimerService::~TimerService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+TimerService::TimerId TimerService::schedule(Clock::time_point deadline, std::function<void()> callback) {
+    bool earliest;
+    TimerId id;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!thread.joinable()) {
+            thread = std::thread(&TimerService::run, this);
+        }
+        id = nextId++;
+        earliest = timers.empty() || deadline < timers.top().deadline;
+        timers.push(Entry{deadline, id, std::move(callback)});
+        pending.insert(id);
+    }
+    // Only a new earliest deadline changes how long the thread must sleep.
+    if (earliest) {
+        wakeup.notify_one();
+    }
+    return id;
+}
+
+bool TimerService::cancel(TimerId id) {
+    // The entry stays in the heap and is discarded when it reaches the top.
+    std::unique_lock<std::mutex> lock(mutex);
+    if (pending.erase(id) > 0) {
+        return true;
+    }
+    // A callback that cancels its own timer must not wait for itself.
+    if (std::this_thread::get_id() != thread.get_id()) {
+        firingDone.wait(lock, [this, id]() { return firing != id; });
+    }
+    return false;
+}
+
+void TimerService::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        if (timers.empty()) {
+            wakeup.wait(lock);
+            continue;
+        }
+        if (pending.find(timers.top().id) == pending.end()) {
+            timers.pop(); // Cancelled.
+            continue;
+        }
+        const Clock::time_point deadline = timers.top().deadline;
+        if (Clock::now() < deadline) {
+            wakeup.wait_until(lock, deadline);
+            continue;
+        }
+
+        // priority_queue::top() is const; the entry is popped right after the move.
+        std::function<void()> callback = std::move(const_cast<Entry&>(timers.top()).callback);
+        firing = timers.top().id;
+        pending.erase(firing);
+        timers.pop();
+        lock.unlock();
+        callback();
+        lock.lock();
+        firing = 0;
+        firingDone.notify_all();
+    }
+}
@@ -0,0 +1,24 @@
+#include "TokenBucketPacer.h"
+
+void TokenBucketPacer::start(long long bitsPerSecond, size_t burstBytes, Clock::time_point now) {
+    origin = now;
+    nsPerByte = bitsPerSecond > 0 ? 8e9 / static_cast<double>(bitsPerSecond) : 0.0;
+    burstNs = static_cast<double>(burstBytes) * nsPerByte;
+    nextSendNs = 0.0;
+}
+
+TokenBucketPacer::Clock::time_point TokenBucketPacer::reserve(size_t bytes, Clock::time_point now) {
+    const double nowNs = std::chrono::duration<double, std::nano>(now - origin).count();
+    // A schedule more than one burst behind the clock would overflow the bucket;
+    // the excess tokens are lost instead of being sent as one large burst.
+    if (nextSendNs < nowNs - burstNs) {
+        nextSendNs = nowNs - burstNs;
+    }
+    const double sendNs = nextSendNs;
+    nextSendNs += static_cast<double>(bytes) * nsPerByte;
+    return origin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::nano>(sendNs));
+}
+
+TokenBucketPacer::Clock::time_point TokenBucketPacer::drainedAt() const {
+    return origin + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::nano>(nextSendNs));
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @class TokenBucketPacer
+ * @brief Spaces sends so that a stream averages a target bit rate.
+ *
+ * Tokens (bytes) accrue continuously at the target rate into a bucket that
+ * holds at most `burst` bytes and starts empty. reserve() spends the tokens
+ * for a send and returns when the send may start; a send that finds tokens
+ * missing waits for the deficit. The state is the ideal start time of the next
+ * send, kept in fractional nanoseconds, so rates that do not divide a
+ * nanosecond evenly accumulate no rounding drift.
+ *
+ * The bucket lets the sender make up for a timer that fires late, as long as
+ * the delay stays within the burst; the average rate is therefore exact even
+ * when individual gaps are shorter than the timer resolution.
+ */
+class TokenBucketPacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Starts pacing with an empty bucket, so the first send goes out at once.
+     * @param bitsPerSecond Target rate; 0 disables pacing.
+     * @param burstBytes Largest amount that may be sent back to back to catch up.
+     * @param now Start of the schedule.
+     */
+    void start(long long bitsPerSecond, size_t burstBytes, Clock::time_point now);
+
+    /** @brief True if a rate was set. */
+    bool enabled() const { return nsPerByte > 0.0; }
+
+    /**
+     * @brief Takes the tokens for a send of `bytes`.
+     * @return When the send may start; not later than now if tokens were available.
+     */
+    Clock::time_point reserve(size_t bytes, Clock::time_point now);
+
+    /**
+     * @brief When every reserved byte has been paid for at the target rate.
+     * Waiting for this after the last send makes the measured duration cover
+     * the last send's share of time as well.
+     */
+    Clock::time_point drainedAt() const;
+
+private:
+    Clock::time_point origin;
+    double nsPerByte = 0.0;
+    double burstNs = 0.0;
+    /** Ideal start of the next send, in ns since origin. */
+    double nextSendNs = 0.0;
+};
@@ -5,12 +5,25 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <string.h> // For strerror
+#include <linux/errqueue.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 
+/**< Smaller sends are copied: below ~10KB page pinning and the completion
+ *   notification cost more than the copy they save. */
+static constexpr size_t kZeroCopyMinBytes = 16 * 1024;
+
+/**< Matches the request size of PacketReceiver; larger requests allocate. */
+static constexpr size_t kReceiveBufferSize = 64 * 1024;
+/**< A receive buffer goes back to the pool as soon as its callback returns,
+ *   so a few idle buffers cover every connection of this interface. */
+static constexpr size_t kReceiveBufferPoolSize = 4;
+
 /**
  * @brief Helper function to set a socket to non-blocking mode.
  * @param fd The file descriptor of the socket.
@@ -33,7 +46,8 @@ static bool setNonBlocking(int fd) {
  * @brief Constructs the LinuxAsyncNetworkInterface.
  */
 LinuxAsyncNetworkInterface::LinuxAsyncNetworkInterface() 
-    : listenFd(-1), clientFd(-1), epollFd(-1), running(false) {}
+    : listenFd(-1), clientFd(-1), epollFd(-1), running(false), wakeFd(-1), timerFd(-1),
+      recvPool(kReceiveBufferSize, kReceiveBufferPoolSize) {}
 
 /**
  * @brief Destructor.
@@ -56,11 +70,41 @@ bool LinuxAsyncNetworkInterface::initialize(const std::string& ip, int port) {
         return false;
     }
 
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd == -1) {
+        Logger::log("Error: eventfd failed: " + std::string(strerror(errno)));
+        closeDescriptors();
+        return false;
+    }
+    auto wakeData = std::make_unique<SocketData>();
+    wakeData->fd = wakeFd;
+    wakeData->operationType = LinuxOperationType::Wakeup;
+    addFdToEpoll(wakeFd, EPOLLIN | EPOLLET, wakeData.get());
+    {
+        std::lock_guard<std::mutex> lock(socketDataMutex);
+        socketDataMap[wakeFd] = std::move(wakeData);
+    }
+
+    timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd == -1) {
+        Logger::log("Error: timerfd_create failed: " + std::string(strerror(errno)));
+        closeDescriptors();
+        return false;
+    }
+    auto timerData = std::make_unique<SocketData>();
+    timerData->fd = timerFd;
+    timerData->operationType = LinuxOperationType::Timer;
+    addFdToEpoll(timerFd, EPOLLIN | EPOLLET, timerData.get());
+    {
+        std::lock_guard<std::mutex> lock(socketDataMutex);
+        socketDataMap[timerFd] = std::move(timerData);
+    }
+
     if (port != 0) { // Server mode: set up listening socket
         listenFd = socket(AF_INET, SOCK_STREAM, 0);
         if (listenFd == -1) {
             Logger::log("Error: socket creation failed: " + std::string(strerror(errno)));
-            ::close(epollFd);
+            closeDescriptors();
             return false;
         }
 
@@ -70,8 +114,7 @@ bool LinuxAsyncNetworkInterface::initialize(const std::string& ip, int port) {
         }
 
         if (!setNonBlocking(listenFd)) {
-            ::close(listenFd);
-            ::close(epollFd);
+            closeDescriptors();
             return false;
         }
 
@@ -85,8 +128,7 @@ bool LinuxAsyncNetworkInterface::initialize(const std::string& ip, int port) {
                 serverAddr.sin_addr.s_addr = INADDR_ANY;
             else {
                 Logger::log("Error: Invalid IP address: " + ip);
-                ::close(listenFd);
-                ::close(epollFd);
+                closeDescriptors();
                 return false;
             }
         }
@@ -94,24 +136,22 @@ bool LinuxAsyncNetworkInterface::initialize(const std::string& ip, int port) {
 
         if (bind(listenFd, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) == -1) {
             Logger::log("Error: bind failed: " + std::string(strerror(errno)));
-            ::close(listenFd);
-            ::close(epollFd);
+            closeDescriptors();
             return false;
         }
 
         if (listen(listenFd, SOMAXCONN) == -1) {
             Logger::log("Error: listen failed: " + std::string(strerror(errno)));
-            ::close(listenFd);
-            ::close(epollFd);
+            closeDescriptors();
             return false;
         }
 
         auto listenData = std::make_unique<SocketData>();
         listenData->fd = listenFd;
         listenData->operationType = LinuxOperationType::Accept;
-        listenData->currentEvents = EPOLLIN; // Always listen for connections
+        listenData->readReady = true; // Connections may already be queued
 
-        addFdToEpoll(listenFd, listenData->currentEvents, listenData.get());
+        addFdToEpoll(listenFd, EPOLLIN | EPOLLET, listenData.get());
 
         std::lock_guard<std::mutex> lock(socketDataMutex);
         socketDataMap[listenFd] = std::move(listenData);
@@ -138,34 +178,44 @@ void LinuxAsyncNetworkInterface::close() {
         return; // Already closed
     }
 
-    // Closing the epollFd will cause the epoll_wait in the worker thread to unblock (or fail).
-    if (epollFd != -1) {
-        ::close(epollFd);
-        epollFd = -1;
+    // Wake the worker so it notices running == false without waiting for the epoll timeout.
+    if (wakeFd != -1) {
+        uint64_t one = 1;
+        if (::write(wakeFd, &one, sizeof(one)) == -1 && errno != EAGAIN) {
+            Logger::log("Warning: eventfd write failed: " + std::string(strerror(errno)));
+        }
     }
 
     if (epollThread.joinable()) {
         epollThread.join();
     }
 
-    if (listenFd != -1) {
-        ::close(listenFd);
-        listenFd = -1;
-    }
-    if (clientFd != -1) {
-        ::close(clientFd);
-        clientFd = -1;
-    }
-    
-    // Clear map
-    {
-        std::lock_guard<std::mutex> lock(socketDataMutex);
-        socketDataMap.clear();
-    }
+    // Timers still pending are dropped like any other pending operation.
+    closeDescriptors();
+    wakePending = false;
 
     Logger::log("Info: Network interface closed.");
 }
 
+/**
+ * @brief Closes every descriptor the interface owns, resets each to -1, and
+ * forgets the socket data and timers. Used by close() and to unwind a failed
+ * initialize().
+ */
+void LinuxAsyncNetworkInterface::closeDescriptors() {
+    for (int* fd : {&listenFd, &clientFd, &wakeFd, &timerFd, &epollFd}) {
+        if (*fd != -1) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(socketDataMutex);
+    socketDataMap.clear();
+    timers.clear();
+    armedDeadline = std::chrono::steady_clock::time_point::max();
+}
+
 /**
  * @brief Asynchronously connects to a server.
  * @param ip The server's IP address.
@@ -173,20 +223,13 @@ void LinuxAsyncNetworkInterface::close() {
  * @param callback The function to call upon completion.
  */
 void LinuxAsyncNetworkInterface::doAsyncConnect(const std::string& ip, int port, ConnectCallback callback) {
-    clientFd = socket(AF_INET, SOCK_STREAM, 0);
+    clientFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
     if (clientFd == -1) {
         Logger::log("Error: Socket creation for connect failed: " + std::string(strerror(errno)));
         callback(false);
         return;
     }
 
-    if (!setNonBlocking(clientFd)) {
-        ::close(clientFd);
-        clientFd = -1;
-        callback(false);
-        return;
-    }
-
     sockaddr_in serverAddr;
     memset(&serverAddr, 0, sizeof(serverAddr));
     serverAddr.sin_family = AF_INET;
@@ -194,21 +237,6 @@ void LinuxAsyncNetworkInterface::doAsyncConnect(const std::string& ip, int port,
     serverAddr.sin_port = htons(port);
 
     int res = ::connect(clientFd, (struct sockaddr*)&serverAddr, sizeof(serverAddr));
-    if (res == 0) {
-        // Immediate connection
-        auto clientData = std::make_unique<SocketData>();
-        clientData->fd = clientFd;
-        clientData->operationType = LinuxOperationType::Recv;
-        clientData->currentEvents = 0; // Nothing yet
-
-        {
-             std::lock_guard<std::mutex> lock(socketDataMutex);
-             socketDataMap[clientFd] = std::move(clientData);
-        }
-        callback(true);
-        return;
-    }
-
     if (res == -1 && errno != EINPROGRESS) {
         Logger::log("Error: connect failed immediately: " + std::string(strerror(errno)));
         ::close(clientFd);
@@ -217,17 +245,30 @@ void LinuxAsyncNetworkInterface::doAsyncConnect(const std::string& ip, int port,
         return;
     }
 
-    // Connection is in progress. Add to epoll to monitor for writability (EPOLLOUT).
+    // The socket is registered once, here, for everything it will ever do.
     auto clientData = std::make_unique<SocketData>();
     clientData->fd = clientFd;
-    clientData->operationType = LinuxOperationType::Connect;
-    clientData->connectCallback = callback;
-    clientData->currentEvents = EPOLLOUT;
-    
-    addFdToEpoll(clientFd, clientData->currentEvents, clientData.get());
-    
-    std::lock_guard<std::mutex> lock(socketDataMutex);
-    socketDataMap[clientFd] = std::move(clientData);
+    SocketData* raw = clientData.get();
+    if (res == 0) {
+        // Immediate connection
+        clientData->operationType = LinuxOperationType::Recv;
+        clientData->readReady = true;
+        clientData->writeReady = true;
+    } else {
+        // Connection is in progress; the first EPOLLOUT edge reports its outcome.
+        clientData->operationType = LinuxOperationType::Connect;
+        clientData->connectCallback = callback;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(socketDataMutex);
+        socketDataMap[clientFd] = std::move(clientData);
+    }
+    addFdToEpoll(clientFd, EPOLLIN | EPOLLOUT | EPOLLET | EPOLLRDHUP, raw);
+
+    if (res == 0) {
+        callback(true);
+    }
 }
 
 /**
@@ -235,15 +276,20 @@ void LinuxAsyncNetworkInterface::doAsyncConnect(const std::string& ip, int port,
  * @param callback The function to call upon completion.
  */
 void LinuxAsyncNetworkInterface::doAsyncAccept(AcceptCallback callback) {
-    if (listenFd != -1) {
+    if (listenFd == -1) {
+        Logger::log("Error: asyncAccept called but no listen socket is configured.");
+        return;
+    }
+    {
         std::lock_guard<std::mutex> lock(socketDataMutex);
-        if (socketDataMap.count(listenFd)) {
-            socketDataMap[listenFd]->acceptCallback = callback;
-            // Listen socket is always monitored for EPOLLIN in initialize, so no need to add again.
+        auto it = socketDataMap.find(listenFd);
+        if (it == socketDataMap.end()) {
+            return;
         }
-    } else {
-        Logger::log("Error: asyncAccept called but no listen socket is configured.");
+        it->second->acceptCallback = std::move(callback);
+        it->second->acceptPending = true;
     }
+    notifyWorker();
 }
 
 /**
@@ -251,67 +297,164 @@ void LinuxAsyncNetworkInterface::doAsyncAccept(AcceptCallback callback) {
  * @param data The data to send.
  * @param callback The function to call upon completion.
  */
-void LinuxAsyncNetworkInterface::doAsyncSend(const std::vector<char>& data, SendCallback callback) {
+void LinuxAsyncNetworkInterface::doAsyncSend(std::vector<char> data, SendCallback callback) {
+    PendingSend pending;
+    pending.data = std::move(data);
+    pending.bytes = pending.data.data();
+    pending.size = pending.data.size();
+    pending.callback = std::move(callback);
+    queueSend(std::move(pending));
+}
+
+/**
+ * @brief Asynchronously sends bytes borrowed from the caller.
+ * @param data The caller's bytes, valid until the callback runs.
+ * @param callback The function to call upon completion.
+ */
+void LinuxAsyncNetworkInterface::doAsyncSendSpan(std::span<const char> data, SendCallback callback) {
+    PendingSend pending;
+    pending.bytes = data.data();
+    pending.size = data.size();
+    pending.callback = std::move(callback);
+    queueSend(std::move(pending));
+}
+
+void LinuxAsyncNetworkInterface::queueSend(PendingSend pending) {
     if (clientFd == -1) {
         Logger::log("Error: asyncSend called on an invalid socket.");
-        callback(0);
+        pending.callback(0);
         return;
     }
 
-    std::lock_guard<std::mutex> lock(socketDataMutex);
-    auto it = socketDataMap.find(clientFd);
-    if (it == socketDataMap.end()) {
-         Logger::log("Error: asyncSend socket data not found.");
-         callback(0);
-         return;
-    }
-    auto& socketData = it->second;
-    socketData->sendData.insert(socketData->sendData.end(), data.begin(), data.end());
-    socketData->sendCallback = callback;
-
-    // Enable EPOLLOUT to get notified when we can write
-    if (!(socketData->currentEvents & EPOLLOUT)) {
-        socketData->currentEvents |= EPOLLOUT;
-        addFdToEpoll(clientFd, socketData->currentEvents, socketData.get());
+    {
+        std::lock_guard<std::mutex> lock(socketDataMutex);
+        auto it = socketDataMap.find(clientFd);
+        if (it == socketDataMap.end()) {
+            Logger::log("Error: asyncSend socket data not found.");
+            pending.callback(0);
+            return;
+        }
+        it->second->sendQueue.push_back(std::move(pending));
     }
+    notifyWorker();
 }
 
 /**
- * @brief Asynchronously receives data.
+ * @brief Asynchronously receives data into a pooled buffer lent to the callback.
  * @param bufferSize The size of the buffer to use.
  * @param callback The function to call upon completion.
  */
 void LinuxAsyncNetworkInterface::doAsyncReceive(size_t bufferSize, RecvCallback callback) {
+    queueReceive(bufferSize, nullptr, std::move(callback), nullptr);
+}
+
+/**
+ * @brief Asynchronously receives data straight into the caller's buffer.
+ * @param buffer The caller's memory, written until the callback runs.
+ * @param callback The function to call upon completion.
+ */
+void LinuxAsyncNetworkInterface::doAsyncReceiveInto(std::span<char> buffer, RecvIntoCallback callback) {
+    queueReceive(buffer.size(), buffer.data(), nullptr, std::move(callback));
+}
+
+void LinuxAsyncNetworkInterface::queueReceive(size_t size, char* target,
+                                              RecvCallback recvCallback, RecvIntoCallback recvIntoCallback) {
+    auto fail = [&]() {
+        if (recvCallback) {
+            recvCallback({}, 0);
+        } else {
+            recvIntoCallback(0);
+        }
+    };
+
     if (clientFd == -1) {
         Logger::log("Error: asyncReceive called on an invalid socket.");
-        callback({}, 0);
+        fail();
         return;
     }
 
+    {
+        std::lock_guard<std::mutex> lock(socketDataMutex);
+        auto it = socketDataMap.find(clientFd);
+        if (it == socketDataMap.end()) {
+            Logger::log("Error: asyncReceive socket data not found.");
+            fail();
+            return;
+        }
+        auto& socketData = it->second;
+        socketData->recvCallback = std::move(recvCallback);
+        socketData->recvIntoCallback = std::move(recvIntoCallback);
+        socketData->recvTarget = target;
+        socketData->recvSize = size;
+        socketData->recvPending = true;
+    }
+    notifyWorker();
+}
+
+NetworkIoStats LinuxAsyncNetworkInterface::getIoStats() const {
+    NetworkIoStats stats;
+    stats.backend = "epoll";
+    stats.sendCalls = sendCalls.load(std::memory_order_relaxed);
+    stats.recvCalls = recvCalls.load(std::memory_order_relaxed);
+    stats.waitCalls = waitCalls.load(std::memory_order_relaxed);
+    stats.controlCalls = controlCalls.load(std::memory_order_relaxed);
+    stats.wakeupCalls = wakeupCalls.load(std::memory_order_relaxed);
+    stats.zeroCopySends = zeroCopySends.load(std::memory_order_relaxed);
+    stats.zeroCopyCompleted = zeroCopyCompleted.load(std::memory_order_relaxed);
+    stats.zeroCopyCopied = zeroCopyCopied.load(std::memory_order_relaxed);
+    stats.recvBufferHits = recvPool.hits();
+    stats.recvBufferMisses = recvPool.misses();
+    stats.recvDirect = recvDirect.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool LinuxAsyncNetworkInterface::setZeroCopySend(bool enabled) {
+    zeroCopyRequested = enabled;
+    if (!enabled) {
+        return true; // Buffers already pinned are released as notifications arrive.
+    }
+
     std::lock_guard<std::mutex> lock(socketDataMutex);
     auto it = socketDataMap.find(clientFd);
     if (it == socketDataMap.end()) {
-         Logger::log("Error: asyncReceive socket data not found.");
-         callback({}, 0);
-         return;
+        zeroCopyRequested = false;
+        return false;
     }
-    auto& socketData = it->second;
-    socketData->recvCallback = callback;
-    // Resize buffer if needed, or just ensure it's large enough.
-    // We will resize it after reading to reflect actual bytes read.
-    if (socketData->buffer.size() < bufferSize) {
-        socketData->buffer.resize(bufferSize);
+    SocketData& socketData = *it->second;
+    if (!socketData.zeroCopy) {
+        int one = 1;
+        controlCalls.fetch_add(1, std::memory_order_relaxed);
+        if (setsockopt(socketData.fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) == -1) {
+            Logger::log("Warning: setsockopt(SO_ZEROCOPY) failed: " + std::string(strerror(errno)));
+            zeroCopyRequested = false;
+            return false;
+        }
+        socketData.zeroCopy = true;
+        Logger::log("Info: Zero-copy send enabled (MSG_ZEROCOPY for sends >= " +
+                    std::to_string(kZeroCopyMinBytes) + " bytes).");
     }
+    return true;
+}
 
-    // Enable EPOLLIN to get notified when data is available
-    if (!(socketData->currentEvents & EPOLLIN)) {
-        socketData->currentEvents |= EPOLLIN;
-        addFdToEpoll(clientFd, socketData->currentEvents, socketData.get());
+bool LinuxAsyncNetworkInterface::setPacingRate(uint64_t bytesPerSecond) {
+    std::lock_guard<std::mutex> lock(socketDataMutex);
+    auto it = socketDataMap.find(clientFd);
+    if (it == socketDataMap.end()) {
+        return bytesPerSecond == 0;
+    }
+    // The 64-bit form is read in full since Linux 5.0 and as its low int before,
+    // where ~0U also means "no cap".
+    const uint64_t rate = bytesPerSecond > 0 ? bytesPerSecond : ~0ULL;
+    controlCalls.fetch_add(1, std::memory_order_relaxed);
+    if (setsockopt(it->second->fd, SOL_SOCKET, SO_MAX_PACING_RATE, &rate, sizeof(rate)) == -1) {
+        Logger::log("Warning: setsockopt(SO_MAX_PACING_RATE) failed: " + std::string(strerror(errno)));
+        return false;
     }
+    return true;
 }
 
 /**
- * @brief Adds or modifies a file descriptor in the epoll set.
+ * @brief Registers a file descriptor with the epoll set.
  * @param fd The file descriptor.
  * @param events The events to monitor.
  * @param data Pointer to the associated SocketData.
@@ -320,30 +463,361 @@ void LinuxAsyncNetworkInterface::addFdToEpoll(int fd, uint32_t events, SocketDat
     epoll_event event;
     event.events = events;
     event.data.ptr = data;
-    if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event) == -1) {
-        if (errno == ENOENT) { // If it does not exist, add it.
-             if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
-                Logger::log("Error: epoll_ctl(ADD) failed for fd " + std::to_string(fd) + ": " + std::string(strerror(errno)));
-             }
+    controlCalls.fetch_add(1, std::memory_order_relaxed);
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) == -1) {
+        Logger::log("Error: epoll_ctl(ADD) failed for fd " + std::to_string(fd) + ": " + std::string(strerror(errno)));
+    }
+}
+
+void LinuxAsyncNetworkInterface::doAsyncWait(std::chrono::steady_clock::time_point deadline, TimerCallback callback) {
+    // No notifyWorker(): arming the timerfd wakes epoll_wait by itself.
+    std::lock_guard<std::mutex> lock(socketDataMutex);
+    timers.emplace(deadline, std::move(callback));
+    if (deadline < armedDeadline) {
+        armTimer(deadline);
+    }
+}
+
+void LinuxAsyncNetworkInterface::armTimer(std::chrono::steady_clock::time_point deadline) {
+    // steady_clock is CLOCK_MONOTONIC, so the deadline converts directly to an absolute expiry.
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(sinceEpoch / 1'000'000'000);
+    spec.it_value.tv_nsec = static_cast<long>(sinceEpoch % 1'000'000'000);
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0) {
+        spec.it_value.tv_nsec = 1; // All zero would disarm the timer.
+    }
+    controlCalls.fetch_add(1, std::memory_order_relaxed);
+    if (timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) == -1) {
+        Logger::log("Error: timerfd_settime failed: " + std::string(strerror(errno)));
+        return;
+    }
+    armedDeadline = deadline;
+}
+
+void LinuxAsyncNetworkInterface::expireTimers(std::vector<LinuxCompletion>& completions) {
+    if (timers.empty()) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    auto it = timers.begin();
+    while (it != timers.end() && it->first <= now) {
+        LinuxCompletion completion;
+        completion.other = std::move(it->second);
+        completions.push_back(std::move(completion));
+        it = timers.erase(it);
+    }
+    if (it == timers.end()) {
+        // A stale expiry only costs one spurious timerfd read.
+        armedDeadline = std::chrono::steady_clock::time_point::max();
+    } else if (it->first != armedDeadline) {
+        armTimer(it->first);
+    }
+}
+
+/**
+ * @brief Wakes the worker for a request issued on another thread.
+ */
+void LinuxAsyncNetworkInterface::notifyWorker() {
+    if (std::this_thread::get_id() == epollThread.get_id()) {
+        return; // The worker drains queued requests before it waits again.
+    }
+    if (wakePending.exchange(true)) {
+        return; // A wakeup is already on its way.
+    }
+    uint64_t one = 1;
+    wakeupCalls.fetch_add(1, std::memory_order_relaxed);
+    if (::write(wakeFd, &one, sizeof(one)) == -1 && errno != EAGAIN) {
+        Logger::log("Error: eventfd write failed: " + std::string(strerror(errno)));
+    }
+}
+
+/**
+ * @brief Performs the pending operations of one descriptor for which readiness is latched.
+ * @param data The descriptor state. socketDataMutex must be held.
+ * @param completions Callbacks to invoke once the mutex is released.
+ */
+void LinuxAsyncNetworkInterface::driveSocket(SocketData& data, std::vector<LinuxCompletion>& completions) {
+    // --- Server Accept ---
+    if (data.operationType == LinuxOperationType::Accept) {
+        if (!data.acceptPending || !data.readReady) {
+            return;
+        }
+        sockaddr_in clientAddr;
+        socklen_t clientLen = sizeof(clientAddr);
+        recvCalls.fetch_add(1, std::memory_order_relaxed);
+        int connFd = ::accept4(data.fd, (struct sockaddr*)&clientAddr, &clientLen, SOCK_NONBLOCK);
+        if (connFd == -1) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                data.readReady = false; // Wait for the next EPOLLIN edge.
+            } else if (errno != EINTR) {
+                Logger::log("Error: accept failed: " + std::string(strerror(errno)));
+                data.readReady = false;
+            }
+            return;
+        }
+
+        clientFd = connFd; // Store accepted FD
+
+        auto clientData = std::make_unique<SocketData>();
+        clientData->fd = connFd;
+        clientData->operationType = LinuxOperationType::Recv;
+        clientData->readReady = true;
+        clientData->writeReady = true;
+        addFdToEpoll(connFd, EPOLLIN | EPOLLOUT | EPOLLET | EPOLLRDHUP, clientData.get());
+        socketDataMap[connFd] = std::move(clientData);
+
+        char ipStr[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &clientAddr.sin_addr, ipStr, INET_ADDRSTRLEN);
+        int port = ntohs(clientAddr.sin_port);
+
+        data.acceptPending = false;
+        AcceptCallback acceptCb = std::move(data.acceptCallback);
+        data.acceptCallback = nullptr;
+        LinuxCompletion completion;
+        completion.other = [acceptCb = std::move(acceptCb), ip = std::string(ipStr), port]() {
+            acceptCb(true, ip, port);
+        };
+        completions.push_back(std::move(completion));
+        return;
+    }
+
+    // --- Client Connect ---
+    if (data.operationType == LinuxOperationType::Connect) {
+        if (!data.writeReady) {
+            return;
+        }
+        int error = 0;
+        socklen_t len = sizeof(error);
+        controlCalls.fetch_add(1, std::memory_order_relaxed);
+        if (getsockopt(data.fd, SOL_SOCKET, SO_ERROR, &error, &len) < 0) {
+            error = errno;
+        }
+        ConnectCallback connectCb = std::move(data.connectCallback);
+        data.connectCallback = nullptr;
+        if (error != 0) {
+            Logger::log("Error: Async connect failed: " + std::string(strerror(error)));
+            data.closed = true;
+        }
+        // Readiness seen so far belonged to the handshake; probe afresh.
+        data.operationType = LinuxOperationType::Recv;
+        data.readReady = true;
+        if (connectCb) {
+            LinuxCompletion completion;
+            completion.other = [connectCb = std::move(connectCb), ok = error == 0]() { connectCb(ok); };
+            completions.push_back(std::move(completion));
+        }
+        return;
+    }
+
+    if (data.operationType != LinuxOperationType::Recv) {
+        return;
+    }
+
+    if (data.errQueueReady) {
+        drainZeroCopyNotifications(data);
+    }
+
+    // --- Send: drain the queue in order while the socket accepts data ---
+    const bool zeroCopyWanted = data.zeroCopy && zeroCopyRequested.load(std::memory_order_relaxed);
+    while (!data.sendQueue.empty() && (data.writeReady || data.closed)) {
+        PendingSend& pending = data.sendQueue.front();
+        if (!data.closed) {
+            const size_t remaining = pending.size - pending.offset;
+            // Only handed-over buffers can stay pinned until the kernel lets go of them.
+            bool useZeroCopy = zeroCopyWanted && !pending.data.empty() && remaining >= kZeroCopyMinBytes;
+            sendCalls.fetch_add(1, std::memory_order_relaxed);
+            ssize_t sent = ::send(data.fd, pending.bytes + pending.offset, remaining,
+                                  MSG_NOSIGNAL | (useZeroCopy ? MSG_ZEROCOPY : 0));
+            if (sent == -1 && useZeroCopy && errno == ENOBUFS) {
+                // Out of optmem for notifications: copy this send instead.
+                zeroCopyCopied.fetch_add(1, std::memory_order_relaxed);
+                useZeroCopy = false;
+                sendCalls.fetch_add(1, std::memory_order_relaxed);
+                sent = ::send(data.fd, pending.bytes + pending.offset, remaining, MSG_NOSIGNAL);
+            }
+            if (sent >= 0) {
+                if (useZeroCopy) {
+                    zeroCopySends.fetch_add(1, std::memory_order_relaxed);
+                    pending.zeroCopy = true;
+                    pending.lastZeroCopyId = data.zeroCopyNextId++;
+                }
+                pending.offset += static_cast<size_t>(sent);
+                if (pending.offset < pending.size) {
+                    continue; // Short write: the socket buffer is full, next call reports EAGAIN.
+                }
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                data.writeReady = false;
+                break;
+            } else if (errno == EINTR) {
+                continue;
+            } else {
+                Logger::log("Error: send failed: " + std::string(strerror(errno)));
+                data.closed = true;
+            }
+        }
+        size_t bytesSent = data.closed ? 0 : pending.offset;
+        SendCallback sendCb = std::move(pending.callback);
+        if (pending.zeroCopy && !data.closed) {
+            // The kernel still references these pages; keep them until notified.
+            data.pinnedSends.push_back(PinnedSend{pending.lastZeroCopyId, std::move(pending.data)});
+        }
+        data.sendQueue.pop_front();
+        if (sendCb) {
+            LinuxCompletion completion;
+            completion.sendCallback = std::move(sendCb);
+            completion.bytes = bytesSent;
+            completions.push_back(std::move(completion));
+        }
+    }
+
+    // --- Receive ---
+    if (data.recvPending && (data.readReady || data.closed)) {
+        std::vector<char> receivedData;
+        size_t bytesReceived = 0;
+        bool done = true;
+        if (!data.closed) {
+            char* target = data.recvTarget;
+            if (target) {
+                recvDirect.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                receivedData = recvPool.acquire(data.recvSize);
+                target = receivedData.data();
+            }
+            recvCalls.fetch_add(1, std::memory_order_relaxed);
+            ssize_t bytesRead = ::recv(data.fd, target, data.recvSize, 0);
+            if (bytesRead > 0) {
+                bytesReceived = static_cast<size_t>(bytesRead);
+            } else if (bytesRead == 0) {
+                Logger::log("Info: Connection closed by peer.");
+                data.closed = true;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                data.readReady = false;
+                done = false;
+            } else if (errno == EINTR) {
+                done = false;
+            } else {
+                Logger::log("Error: recv failed: " + std::string(strerror(errno)));
+                data.closed = true;
+            }
+        }
+        if (!done) {
+            recvPool.release(std::move(receivedData));
         } else {
-            Logger::log("Error: epoll_ctl(MOD) failed for fd " + std::to_string(fd) + ": " + std::string(strerror(errno)));
+            data.recvPending = false;
+            LinuxCompletion completion;
+            completion.recvCallback = std::move(data.recvCallback);
+            completion.recvIntoCallback = std::move(data.recvIntoCallback);
+            data.recvCallback = nullptr;
+            data.recvIntoCallback = nullptr;
+            data.recvTarget = nullptr;
+            completion.recvBuffer = std::move(receivedData);
+            completion.bytes = bytesReceived;
+            completions.push_back(std::move(completion));
         }
     }
 }
 
 /**
- * @brief Removes a file descriptor from the epoll set.
- * @param fd The file descriptor to remove.
+ * @brief Reads MSG_ZEROCOPY notifications from the socket error queue.
+ *
+ * Each notification covers an inclusive range of send IDs. Buffers are released
+ * once every ID up to their last send has completed. SO_EE_CODE_ZEROCOPY_COPIED
+ * marks sends the kernel had to copy after all (e.g. loopback or no SG support).
  */
-void LinuxAsyncNetworkInterface::removeFdFromEpoll(int fd) {
-    if (epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, NULL) == -1) {
-        // ENOENT is fine (maybe already closed)
-        if (errno != ENOENT) {
-             Logger::log("Warning: epoll_ctl(DEL) failed for fd " + std::to_string(fd) + ": " + std::string(strerror(errno)));
+void LinuxAsyncNetworkInterface::drainZeroCopyNotifications(SocketData& data) {
+    while (true) {
+        char control[128];
+        msghdr msg{};
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        controlCalls.fetch_add(1, std::memory_order_relaxed);
+        if (::recvmsg(data.fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) == -1) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                Logger::log("Error: recvmsg(MSG_ERRQUEUE) failed: " + std::string(strerror(errno)));
+            }
+            if (errno != EINTR) {
+                data.errQueueReady = false;
+                break;
+            }
+            continue;
+        }
+
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            const bool isRecvErr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                                   (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+            if (!isRecvErr) {
+                continue;
+            }
+            sock_extended_err err;
+            memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+            if (err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+
+            const uint32_t first = err.ee_info;
+            const uint32_t last = err.ee_data;
+            const long long count = static_cast<long long>(last - first) + 1;
+            if (err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) {
+                zeroCopyCopied.fetch_add(count, std::memory_order_relaxed);
+            } else {
+                zeroCopyCompleted.fetch_add(count, std::memory_order_relaxed);
+            }
+
+            for (uint32_t id = first; id != last + 1; ++id) {
+                data.zeroCopyCompletedAhead.insert(id);
+            }
+            auto it = data.zeroCopyCompletedAhead.begin();
+            while (it != data.zeroCopyCompletedAhead.end() && *it == data.zeroCopyCompletedBelow) {
+                ++data.zeroCopyCompletedBelow;
+                it = data.zeroCopyCompletedAhead.erase(it);
+            }
         }
     }
-    std::lock_guard<std::mutex> lock(socketDataMutex);
-    socketDataMap.erase(fd);
+
+    while (!data.pinnedSends.empty() &&
+           data.pinnedSends.front().lastZeroCopyId < data.zeroCopyCompletedBelow) {
+        data.pinnedSends.pop_front();
+    }
+}
+
+/**
+ * @brief Runs every pending operation whose descriptor is ready, then invokes the callbacks.
+ * @return True if at least one operation completed.
+ */
+bool LinuxAsyncNetworkInterface::processReadyOperations() {
+    {
+        std::lock_guard<std::mutex> lock(socketDataMutex);
+        // accept() inserts into the map, so collect the descriptors first.
+        readySockets.clear();
+        for (auto& entry : socketDataMap) {
+            readySockets.push_back(entry.second.get());
+        }
+        for (SocketData* data : readySockets) {
+            driveSocket(*data, completions);
+        }
+        expireTimers(completions);
+    }
+    if (completions.empty()) {
+        return false;
+    }
+    // Callbacks resume coroutines, which usually queue the next operation right away.
+    // They run on this thread only, so they never add to completions while it is walked.
+    for (LinuxCompletion& completion : completions) {
+        if (completion.sendCallback) {
+            completion.sendCallback(completion.bytes);
+        } else if (completion.recvCallback) {
+            completion.recvCallback(completion.recvBuffer, completion.bytes);
+        } else if (completion.recvIntoCallback) {
+            completion.recvIntoCallback(completion.bytes);
+        } else if (completion.other) {
+            completion.other();
+        }
+        // The receive callback only borrows the buffer.
+        recvPool.release(std::move(completion.recvBuffer));
+    }
+    completions.clear();
+    return true;
 }
 
 /**
@@ -352,10 +826,23 @@ void LinuxAsyncNetworkInterface::removeFdFromEpoll(int fd) {
 void LinuxAsyncNetworkInterface::epollWorkerThread() {
     Logger::log("Info: Epoll worker thread starting.");
     const int MAX_EVENTS = 64;
+    // Bound the completion loop so readiness changes are still collected under a steady stream.
+    const int MAX_PASSES = 64;
     epoll_event events[MAX_EVENTS];
 
     while (running) {
-        int numEvents = epoll_wait(epollFd, events, MAX_EVENTS, 500); // 500ms timeout check running
+        bool progressed = false;
+        for (int pass = 0; pass < MAX_PASSES && running; ++pass) {
+            if (!processReadyOperations()) {
+                break;
+            }
+            progressed = true;
+        }
+        if (!running) break;
+
+        // Only block when nothing could be done; otherwise just poll for new edges.
+        waitCalls.fetch_add(1, std::memory_order_relaxed);
+        int numEvents = epoll_wait(epollFd, events, MAX_EVENTS, progressed ? 0 : 500); // 500ms timeout check running
         if (!running) break;
 
         if (numEvents == -1) {
@@ -364,200 +851,49 @@ void LinuxAsyncNetworkInterface::epollWorkerThread() {
             break;
         }
 
+        std::lock_guard<std::mutex> lock(socketDataMutex);
         for (int i = 0; i < numEvents; ++i) {
-            // CAUTION: 'data' is a pointer to the SocketData managed by std::unique_ptr in socketDataMap.
-            // If the map entry is erased, this pointer becomes invalid.
             SocketData* data = static_cast<SocketData*>(events[i].data.ptr);
             if (!data) continue;
 
-            // Handle Errors
-            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
-                // If it's a connect operation, we might have error in SO_ERROR
-                if (data->operationType == LinuxOperationType::Connect) {
-                    // Handled in EPOLLOUT check below usually, but check here too
-                } else {
-                    Logger::log("Error: Epoll error or hang-up on fd: " + std::to_string(data->fd));
-
-                    // Capture necessary data before potential deletion
-                    RecvCallback recvCb = data->recvCallback;
-                    ConnectCallback connectCb = data->connectCallback;
-                    AcceptCallback acceptCb = data->acceptCallback;
-                    int fd = data->fd;
-
-                    if (recvCb) recvCb({}, 0); // Callback with 0 bytes to signal closed/error
-                    if (connectCb) connectCb(false);
-                    if (acceptCb) acceptCb(false, "", 0);
-
-                    ::close(fd);
-                    removeFdFromEpoll(fd);
-                    continue;
+            if (data->operationType == LinuxOperationType::Wakeup) {
+                // Clear the flag before reading so a request queued from now on signals again.
+                wakePending = false;
+                uint64_t count;
+                wakeupCalls.fetch_add(1, std::memory_order_relaxed);
+                if (::read(wakeFd, &count, sizeof(count)) == -1 && errno != EAGAIN) {
+                    Logger::log("Error: eventfd read failed: " + std::string(strerror(errno)));
                 }
+                continue;
             }
-
-            // --- Handle Server Accept (EPOLLIN) ---
-            if (data->fd == listenFd) {
-                if (events[i].events & EPOLLIN) {
-                    sockaddr_in clientAddr;
-                    socklen_t clientLen = sizeof(clientAddr);
-                    int connFd = ::accept(listenFd, (struct sockaddr*)&clientAddr, &clientLen);
-                    if (connFd != -1) {
-                        setNonBlocking(connFd);
-
-                        clientFd = connFd; // Store accepted FD
-
-                        auto clientData = std::make_unique<SocketData>();
-                        clientData->fd = connFd;
-                        clientData->operationType = LinuxOperationType::Recv;
-                        clientData->currentEvents = 0;
-
-                        // Capture callback to invoke outside lock if needed, but here it's fine.
-                        AcceptCallback acceptCb;
-                        {
-                            std::lock_guard<std::mutex> lock(socketDataMutex);
-                            if (socketDataMap.count(listenFd)) {
-                                acceptCb = socketDataMap[listenFd]->acceptCallback;
-                            }
-                            socketDataMap[connFd] = std::move(clientData);
-                        }
-
-                        char ipStr[INET_ADDRSTRLEN];
-                        inet_ntop(AF_INET, &clientAddr.sin_addr, ipStr, INET_ADDRSTRLEN);
-                        int port = ntohs(clientAddr.sin_port);
-
-                        if (acceptCb) {
-                            acceptCb(true, std::string(ipStr), port);
-                        }
-                    } else {
-                         if (errno != EAGAIN && errno != EWOULDBLOCK) {
-                             Logger::log("Error: accept failed: " + std::string(strerror(errno)));
-                         }
-                    }
+            if (data->operationType == LinuxOperationType::Timer) {
+                // Expired timers are collected by the next processReadyOperations().
+                uint64_t expirations;
+                wakeupCalls.fetch_add(1, std::memory_order_relaxed);
+                if (::read(timerFd, &expirations, sizeof(expirations)) == -1 && errno != EAGAIN) {
+                    Logger::log("Error: timerfd read failed: " + std::string(strerror(errno)));
                 }
                 continue;
             }
 
-            // --- Handle Client Connect (EPOLLOUT) ---
-            if (data->operationType == LinuxOperationType::Connect) {
-                if (events[i].events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) {
-                    int error = 0;
-                    socklen_t len = sizeof(error);
-                    if (getsockopt(data->fd, SOL_SOCKET, SO_ERROR, &error, &len) < 0) {
-                         error = errno;
-                    }
-
-                    // Capture callback
-                    ConnectCallback connectCb = data->connectCallback;
-                    int fd = data->fd;
-
-                    // Update state inside lock
-                    {
-                         std::lock_guard<std::mutex> lock(socketDataMutex);
-                         // Re-check validity if needed
-                         if (socketDataMap.count(fd)) {
-                             auto& sd = socketDataMap[fd];
-                             sd->currentEvents &= ~EPOLLOUT;
-                             addFdToEpoll(fd, sd->currentEvents, sd.get());
-
-                             if (error == 0) {
-                                 sd->operationType = LinuxOperationType::Recv;
-                             }
-                         }
-                    }
-
-                    if (error != 0) {
-                        Logger::log("Error: Async connect failed: " + std::string(strerror(error)));
-                        if (connectCb) connectCb(false);
-                    } else {
-                        if (connectCb) connectCb(true);
-                    }
-                    continue;
+            // Latch the edges. Errors and hang-ups make both directions "ready" so the
+            // next syscall reports the failure to whichever operation is pending.
+            // With SO_ZEROCOPY, EPOLLERR mostly announces completion notifications; real
+            // failures also raise EPOLLHUP, so only the error queue is marked then.
+            uint32_t ev = events[i].events;
+            uint32_t failureEvents = EPOLLHUP;
+            if (ev & EPOLLERR) {
+                if (data->zeroCopy) {
+                    data->errQueueReady = true;
+                } else {
+                    failureEvents |= EPOLLERR;
                 }
             }
-
-            // --- Handle Send (EPOLLOUT) ---
-            if (events[i].events & EPOLLOUT) {
-                SendCallback callbackToCall = nullptr;
-                size_t totalBytesSent = 0;
-
-                {
-                    std::lock_guard<std::mutex> lock(socketDataMutex);
-                    // Check if we still have data to send
-                    if (!data->sendData.empty()) {
-                        int sent = ::send(data->fd, data->sendData.data(), data->sendData.size(), MSG_NOSIGNAL);
-                        if (sent >= 0) {
-                             totalBytesSent = sent;
-                             data->sendData.erase(data->sendData.begin(), data->sendData.begin() + sent);
-                        } else {
-                             if (errno != EAGAIN && errno != EWOULDBLOCK) {
-                                 Logger::log("Error: send failed: " + std::string(strerror(errno)));
-                                 // Handle error (close?)
-                             }
-                        }
-                    }
-
-                    // If queue empty, stop listening for EPOLLOUT
-                    if (data->sendData.empty()) {
-                        data->currentEvents &= ~EPOLLOUT;
-                        addFdToEpoll(data->fd, data->currentEvents, data);
-                        // Save callback to call outside lock
-                        callbackToCall = data->sendCallback;
-                    }
-                }
-
-                if (totalBytesSent > 0 && callbackToCall) {
-                    callbackToCall(totalBytesSent);
-                }
+            if (ev & (EPOLLIN | EPOLLRDHUP | failureEvents)) {
+                data->readReady = true;
             }
-
-            // --- Handle Receive (EPOLLIN) ---
-            if (events[i].events & EPOLLIN) {
-                RecvCallback callbackToCall = nullptr;
-                std::vector<char> receivedData;
-                bool connectionClosed = false;
-                int fd = data->fd;
-
-                {
-                    std::lock_guard<std::mutex> lock(socketDataMutex);
-
-                    // Double check if data is still valid in map (paranoid check)
-                    // If removeFdFromEpoll was called, we wouldn't be here, but good practice?
-                    // data pointer is from event, so it should be valid unless we removed it in previous iteration?
-                    // We only process one event per FD per iteration effectively?
-
-                    // Use a temporary buffer to read
-                    std::vector<char> tempBuf(65536); // 64KB read
-                    int bytesRead = ::recv(data->fd, tempBuf.data(), tempBuf.size(), 0);
-
-                    if (bytesRead > 0) {
-                        tempBuf.resize(bytesRead);
-                        receivedData = std::move(tempBuf);
-                        callbackToCall = data->recvCallback;
-
-                        // Disable EPOLLIN until next asyncReceive call
-                        data->currentEvents &= ~EPOLLIN;
-                        addFdToEpoll(data->fd, data->currentEvents, data);
-
-                    } else if (bytesRead == 0) {
-                        // Connection closed
-                        Logger::log("Info: Connection closed by peer.");
-                        callbackToCall = data->recvCallback;
-                        connectionClosed = true;
-                        // We do NOT call removeFdFromEpoll here to avoid deadlock.
-                        // We will do it outside the lock.
-                    } else {
-                        if (errno != EAGAIN && errno != EWOULDBLOCK) {
-                            Logger::log("Error: recv failed: " + std::string(strerror(errno)));
-                        }
-                    }
-                } // Unlock mutex
-
-                if (connectionClosed) {
-                    ::close(fd);
-                    removeFdFromEpoll(fd); // Now safe to call (it locks mutex internally)
-                    if (callbackToCall) callbackToCall({}, 0);
-                } else if (callbackToCall && !receivedData.empty()) {
-                    callbackToCall(receivedData, receivedData.size());
-                }
+            if (ev & (EPOLLOUT | failureEvents)) {
+                data->writeReady = true;
             }
         }
     }
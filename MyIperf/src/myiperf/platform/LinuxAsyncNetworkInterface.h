@@ -3,6 +3,7 @@
 
 #ifndef _WIN32 // Guard for Linux-only compilation
 #include "myiperf/NetworkInterface.h"
+#include "ReceiveBufferPool.h"
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
@@ -11,47 +12,137 @@
 #include <vector>
 #include <thread>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
 #include <map>
 #include <mutex>
+#include <set>
+#include <span>
 #include <functional>
 
 /**
  * @enum LinuxOperationType
- * @brief Defines the type of asynchronous I/O operation for epoll.
+ * @brief Defines the role of a file descriptor registered with epoll.
  */
 enum class LinuxOperationType {
-    Recv,    /**< A receive operation. */
+    Recv,    /**< A connected socket (receive/send). */
     Send,    /**< A send operation. */
-    Accept,  /**< An accept operation (server-side). */
-    Connect  /**< A connect operation (client-side). */
+    Accept,  /**< The listening socket (server-side). */
+    Connect, /**< A socket with a connect in progress (client-side). */
+    Wakeup,  /**< The eventfd used to wake the worker from other threads. */
+    Timer    /**< The timerfd armed for the earliest pending sleepUntil deadline. */
+};
+
+/**
+ * @struct PendingSend
+ * @brief One queued asyncSend request and its progress.
+ */
+struct PendingSend {
+    /**< The bytes to send when the request handed them over; empty for borrowed bytes. */
+    std::vector<char> data;
+    /**< Bytes already written to the socket. */
+    size_t offset = 0;
+    /**< Callback invoked once all bytes were written or the send failed. */
+    SendCallback callback;
+    /**< Start of the bytes to send: data.data() or the caller's borrowed span. */
+    const char* bytes = nullptr;
+    /**< Number of bytes to send. */
+    size_t size = 0;
+    /**< True if any part was sent with MSG_ZEROCOPY, so data must stay pinned. */
+    bool zeroCopy = false;
+    /**< Zero-copy notification ID of the last MSG_ZEROCOPY send of this buffer. */
+    uint32_t lastZeroCopyId = 0;
+};
+
+/**
+ * @struct PinnedSend
+ * @brief A fully written zero-copy buffer waiting for its completion notification.
+ */
+struct PinnedSend {
+    /**< Notification ID after which the kernel no longer references data. */
+    uint32_t lastZeroCopyId;
+    /**< The bytes handed to the kernel by reference. */
+    std::vector<char> data;
+};
+
+/**
+ * @struct LinuxCompletion
+ * @brief A finished operation whose callback runs after socketDataMutex is released.
+ *
+ * Send and receive results are carried in the struct itself rather than in a
+ * closure, so completing them does not allocate. Connect and accept use the
+ * generic closure.
+ */
+struct LinuxCompletion {
+    /**< Set for a completed send; invoked with bytes. */
+    SendCallback sendCallback;
+    /**< Set for a completed receive; invoked with recvBuffer and bytes. */
+    RecvCallback recvCallback;
+    /**< Set for a completed receive into a caller buffer; invoked with bytes. */
+    RecvIntoCallback recvIntoCallback;
+    /**< Pooled buffer holding the received bytes; returned to the pool afterwards. */
+    std::vector<char> recvBuffer;
+    /**< Bytes sent or received. */
+    size_t bytes = 0;
+    /**< Any other completion. */
+    std::function<void()> other;
 };
 
 /**
  * @struct SocketData
  * @brief Contains all necessary data associated with a file descriptor being monitored by epoll.
+ *
+ * Each descriptor is registered once, edge-triggered. Readiness reported by
+ * epoll is latched in readReady/writeReady and cleared only when a syscall
+ * returns EAGAIN, so arming or completing an operation never touches epoll.
  */
 struct SocketData {
     /**< The file descriptor. */
     int fd;
-    /**< The current operation associated with this FD. */
+    /**< The role of this FD. */
     LinuxOperationType operationType;
-    /**< Buffer for receive operations. */
-    std::vector<char> buffer;
-    /**< Buffer for data to be sent. */
-    std::vector<char> sendData;
-    
+    /**< Queued send requests, completed in order. */
+    std::deque<PendingSend> sendQueue;
+    /**< Maximum number of bytes requested by the pending receive. */
+    size_t recvSize = 0;
+    /**< Caller buffer of a pending receiveInto; null when a pooled buffer is lent instead. */
+    char* recvTarget = nullptr;
+    /**< True while an asyncReceive is waiting for data. */
+    bool recvPending = false;
+    /**< True while an asyncAccept is waiting for a connection. */
+    bool acceptPending = false;
+
     // Callbacks for asynchronous operations
     /**< Callback function to be invoked upon completion of a receive operation. */
     RecvCallback recvCallback;
-    /**< Callback function to be invoked upon completion of a send operation. */
-    SendCallback sendCallback;
+    /**< Callback of a pending receive into recvTarget. */
+    RecvIntoCallback recvIntoCallback;
     /**< Callback function to be invoked upon completion of a connect operation. */
     ConnectCallback connectCallback;
     /**< Callback function to be invoked upon completion of an accept operation. */
     AcceptCallback acceptCallback;
 
-    /**< The current events mask being monitored by epoll for this socket. */
-    uint32_t currentEvents = 0;
+    /**< Latched EPOLLIN edge: reading may make progress. */
+    bool readReady = false;
+    /**< Latched EPOLLOUT edge: writing may make progress. */
+    bool writeReady = false;
+    /**< Set when the peer closed the connection or the socket failed. */
+    bool closed = false;
+
+    // MSG_ZEROCOPY state
+    /**< True once SO_ZEROCOPY is set on the socket. */
+    bool zeroCopy = false;
+    /**< Latched EPOLLERR edge: the error queue may hold completion notifications. */
+    bool errQueueReady = false;
+    /**< ID the kernel assigns to the next MSG_ZEROCOPY send. */
+    uint32_t zeroCopyNextId = 0;
+    /**< Every notification ID below this value has completed. */
+    uint32_t zeroCopyCompletedBelow = 0;
+    /**< Completed IDs at or above zeroCopyCompletedBelow (out-of-order notifications). */
+    std::set<uint32_t> zeroCopyCompletedAhead;
+    /**< Written buffers the kernel may still read from, oldest first. */
+    std::deque<PinnedSend> pinnedSends;
 };
 
 /**
@@ -60,6 +151,13 @@ struct SocketData {
  *
  * This class provides a high-performance, scalable network backend for Linux platforms.
  * It uses epoll to handle multiple asynchronous I/O events efficiently with a single worker thread.
+ *
+ * Sockets are registered once with EPOLLIN|EPOLLOUT|EPOLLET. Requests only
+ * update SocketData; the worker performs the I/O whenever a request and the
+ * matching readiness are both present. Requests issued on the worker thread
+ * (the usual case, since coroutines resume there) are picked up before the
+ * next epoll_wait; requests from other threads wake the worker via an eventfd.
+ * In steady state a packet therefore costs one send or recv and nothing else.
  */
 class LinuxAsyncNetworkInterface : public NetworkInterface {
 public:
@@ -120,7 +218,7 @@ public:
      * @param callback The function to call upon completion of the send operation.
      * @override
      */
-    void doAsyncSend(const std::vector<char>& data, SendCallback callback) override;
+    void doAsyncSend(std::vector<char> data, SendCallback callback) override;
 
     /**
      * @brief Asynchronously receives data from the socket.
@@ -130,6 +228,45 @@ public:
      */
     void doAsyncReceive(size_t bufferSize, RecvCallback callback) override;
 
+    /**
+     * @brief Sends directly from the caller's span; no copy is made.
+     * Borrowed bytes are never sent with MSG_ZEROCOPY, as they cannot stay pinned.
+     * @override
+     */
+    void doAsyncSendSpan(std::span<const char> data, SendCallback callback) override;
+
+    /**
+     * @brief Receives directly into the caller's span; no pooled buffer is used.
+     * @override
+     */
+    void doAsyncReceiveInto(std::span<char> buffer, RecvIntoCallback callback) override;
+
+    /**
+     * @brief Returns the syscall counters of this interface.
+     * @override
+     */
+    NetworkIoStats getIoStats() const override;
+
+    /**
+     * @brief Enables MSG_ZEROCOPY for sends of at least kZeroCopyMinBytes.
+     * @return False if SO_ZEROCOPY cannot be set on the connected socket.
+     * @override
+     */
+    bool setZeroCopySend(bool enabled) override;
+
+    /**
+     * @brief Sets SO_MAX_PACING_RATE on the connected socket.
+     * @override
+     */
+    bool setPacingRate(uint64_t bytesPerSecond) override;
+
+    /**
+     * @brief Queues a timer that completes on the worker thread.
+     * A single timerfd in the epoll set is armed for the earliest deadline.
+     * @override
+     */
+    void doAsyncWait(std::chrono::steady_clock::time_point deadline, TimerCallback callback) override;
+
 private:
     // --- Epoll and Socket Management ---
     /**< Listening file descriptor for server mode. */
@@ -147,6 +284,40 @@ private:
     /**< Maps a file descriptor to its associated data. */
     std::map<int, std::unique_ptr<SocketData>> socketDataMap;
 
+    /**< eventfd used to wake the worker for requests from other threads. */
+    int wakeFd;
+    /**< True while a wakeup is outstanding, so concurrent requests write the eventfd once. */
+    std::atomic<bool> wakePending{false};
+
+    /**< timerfd (CLOCK_MONOTONIC) that wakes the worker for the earliest timer. */
+    int timerFd;
+    /**< Pending timers by deadline. Guarded by socketDataMutex. */
+    std::multimap<std::chrono::steady_clock::time_point, TimerCallback> timers;
+    /**< Deadline timerFd is currently armed for. Guarded by socketDataMutex. */
+    std::chrono::steady_clock::time_point armedDeadline = std::chrono::steady_clock::time_point::max();
+
+    // Syscall counters reported through getIoStats()
+    std::atomic<long long> sendCalls{0};
+    std::atomic<long long> recvCalls{0};
+    std::atomic<long long> waitCalls{0};
+    std::atomic<long long> controlCalls{0};
+    std::atomic<long long> wakeupCalls{0};
+    std::atomic<long long> zeroCopySends{0};
+    std::atomic<long long> zeroCopyCompleted{0};
+    std::atomic<long long> zeroCopyCopied{0};
+
+    /**< Whether sends should use MSG_ZEROCOPY (set through setZeroCopySend). */
+    std::atomic<bool> zeroCopyRequested{false};
+
+    /**< Receive buffers lent to callbacks; used on the worker thread only. */
+    ReceiveBufferPool recvPool;
+    /**< Receives written straight into a caller buffer. */
+    std::atomic<long long> recvDirect{0};
+    /**< Completions of the current pass. Kept across passes so their storage is reused. */
+    std::vector<LinuxCompletion> completions;
+    /**< Descriptor snapshot of the current pass, reused like completions. */
+    std::vector<SocketData*> readySockets;
+
     /**
      * @brief The main function for the epoll worker thread.
      * This function waits for I/O events and dispatches them.
@@ -154,18 +325,65 @@ private:
     void epollWorkerThread();
 
     /**
-     * @brief Adds or modifies a file descriptor in the epoll set.
-     * @param fd The file descriptor to add/modify.
-     * @param events The events to monitor (e.g., EPOLLIN, EPOLLOUT).
+     * @brief Registers a file descriptor with epoll for the lifetime of the socket.
+     * @param fd The file descriptor to register.
+     * @param events The events to monitor (e.g., EPOLLIN | EPOLLOUT | EPOLLET).
      * @param data A pointer to the SocketData associated with the FD.
      */
     void addFdToEpoll(int fd, uint32_t events, SocketData* data);
 
     /**
-     * @brief Removes a file descriptor from the epoll set.
-     * @param fd The file descriptor to remove.
+     * @brief Closes and resets every descriptor and clears socketDataMap and the timers.
+     */
+    void closeDescriptors();
+
+    /**
+     * @brief Appends a send request to the connected socket's queue and wakes the worker.
+     */
+    void queueSend(PendingSend pending);
+
+    /**
+     * @brief Arms the receive of the connected socket and wakes the worker.
+     * Exactly one of recvCallback and recvIntoCallback is set.
+     */
+    void queueReceive(size_t size, char* target, RecvCallback recvCallback, RecvIntoCallback recvIntoCallback);
+
+    /**
+     * @brief Makes sure the worker looks at newly queued requests.
+     * A no-op on the worker thread, which drains requests before it waits again.
+     */
+    void notifyWorker();
+
+    /**
+     * @brief Runs every operation that has both a request and readiness.
+     * Callbacks are invoked without holding socketDataMutex.
+     * @return True if any operation completed.
+     */
+    bool processReadyOperations();
+
+    /**
+     * @brief Performs the I/O for one descriptor. Caller holds socketDataMutex.
+     * @param data The descriptor state.
+     * @param completions Receives the callbacks to run after the lock is released.
+     */
+    void driveSocket(SocketData& data, std::vector<LinuxCompletion>& completions);
+
+    /**
+     * @brief Moves the callbacks of expired timers to completions and re-arms
+     * timerFd for the next deadline. Caller holds socketDataMutex.
+     */
+    void expireTimers(std::vector<LinuxCompletion>& completions);
+
+    /**
+     * @brief Arms timerFd for an absolute deadline. Caller holds socketDataMutex.
+     */
+    void armTimer(std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Reads zero-copy completion notifications and releases pinned buffers.
+     * @param data The descriptor state. Caller holds socketDataMutex.
      */
-    void removeFdFromEpoll(int fd);
+    void drainZeroCopyNotifications(SocketData& data);
 };
 
 #endif // !_WIN32
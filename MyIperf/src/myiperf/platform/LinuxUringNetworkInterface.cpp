@@ -0,0 +1,923 @@
+// LinuxUringNetworkInterface.cpp
+#if defined(__linux__) && defined(MYIPERF_HAS_IO_URING)
+#include "platform/LinuxUringNetworkInterface.h"
+#include "myiperf/Logger.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <string.h> // For strerror
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+/**< Number of submission queue entries. The CQ is sized by the kernel (2x). */
+constexpr unsigned kQueueDepth = 256;
+/**< Number of pre-allocated send staging slots. */
+constexpr int kSendSlotCount = 8;
+/**< Size of one send staging slot. Larger sends use a heap copy. */
+constexpr size_t kSendSlotSize = 65536;
+/**< Size of the registered receive buffer (matches PacketReceiver's request). */
+constexpr size_t kReceiveBufferSize = 65536;
+/**< Fixed buffer indices: the interface's receive buffer and registerReceiveMemory()'s memory. */
+constexpr int kReceiveBufferIndex = 0;
+constexpr int kCallerBufferIndex = 1;
+
+int uringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int uringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int uringRegister(int ringFd, unsigned opcode, const void* arg, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, ringFd, opcode, arg, count));
+}
+
+} // namespace
+
+/**
+ * @brief Constructs the LinuxUringNetworkInterface.
+ */
+LinuxUringNetworkInterface::LinuxUringNetworkInterface()
+    : listenFd(-1), clientFd(-1), ringFd(-1), running(false) {}
+
+/**
+ * @brief Destructor.
+ * Ensures all resources are closed.
+ */
+LinuxUringNetworkInterface::~LinuxUringNetworkInterface() {
+    close();
+}
+
+bool LinuxUringNetworkInterface::isSupported() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = uringSetup(4, &params);
+    if (fd < 0) {
+        return false;
+    }
+    ::close(fd);
+    return true;
+}
+
+/**
+ * @brief Creates the io_uring instance and maps the SQ/CQ rings and the SQE array.
+ * @return True on success, false on failure.
+ */
+bool LinuxUringNetworkInterface::setupRing() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFd = uringSetup(kQueueDepth, &params);
+    if (ringFd < 0) {
+        Logger::log("Error: io_uring_setup failed: " + std::string(strerror(errno)));
+        ringFd = -1;
+        return false;
+    }
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    }
+
+    sqRingPtr = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    if (sqRingPtr == MAP_FAILED) {
+        Logger::log("Error: mmap of io_uring SQ ring failed: " + std::string(strerror(errno)));
+        sqRingPtr = nullptr;
+        teardownRing();
+        return false;
+    }
+
+    if (singleMmap) {
+        cqRingPtr = sqRingPtr;
+    } else {
+        cqRingPtr = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+        if (cqRingPtr == MAP_FAILED) {
+            Logger::log("Error: mmap of io_uring CQ ring failed: " + std::string(strerror(errno)));
+            cqRingPtr = nullptr;
+            teardownRing();
+            return false;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqesPtr = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if (sqesPtr == MAP_FAILED) {
+        Logger::log("Error: mmap of io_uring SQE array failed: " + std::string(strerror(errno)));
+        teardownRing();
+        return false;
+    }
+    sqes = static_cast<io_uring_sqe*>(sqesPtr);
+
+    char* sq = static_cast<char*>(sqRingPtr);
+    sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqRingMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    sqEntries = params.sq_entries;
+
+    char* cq = static_cast<char*>(cqRingPtr);
+    cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqRingMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    registerBuffers();
+    return true;
+}
+
+/**
+ * @brief Allocates the send slots and registers the receive buffer with the ring.
+ *
+ * Registration pins the receive buffer once so READ_FIXED avoids the per-call
+ * page lookup. The table gets a second, empty slot that registerReceiveMemory()
+ * fills later with IORING_REGISTER_BUFFERS_UPDATE, which, unlike registering
+ * the table again, does not wait for in-flight operations. Kernels before 5.13
+ * lack both; they get the receive buffer alone. Failure (e.g. a low
+ * RLIMIT_MEMLOCK) is not fatal; receives then fall back to plain IORING_OP_RECV.
+ */
+void LinuxUringNetworkInterface::registerBuffers() {
+    sendSlots.assign(kSendSlotCount * kSendSlotSize, 0);
+    freeSendSlots.clear();
+    for (int i = kSendSlotCount - 1; i >= 0; --i) {
+        freeSendSlots.push_back(i);
+    }
+
+    receiveBuffer.assign(kReceiveBufferSize, 0);
+    iovec vecs[2] = {};
+    vecs[kReceiveBufferIndex].iov_base = receiveBuffer.data();
+    vecs[kReceiveBufferIndex].iov_len = receiveBuffer.size();
+    io_uring_rsrc_register table;
+    memset(&table, 0, sizeof(table));
+    table.nr = 2;
+    table.data = reinterpret_cast<uint64_t>(vecs);
+    controlCalls.fetch_add(1, std::memory_order_relaxed);
+    callerSlotRegistered = uringRegister(ringFd, IORING_REGISTER_BUFFERS2, &table, sizeof(table)) == 0;
+    buffersRegistered = callerSlotRegistered;
+    if (!buffersRegistered) {
+        controlCalls.fetch_add(1, std::memory_order_relaxed);
+        buffersRegistered = uringRegister(ringFd, IORING_REGISTER_BUFFERS, &vecs[kReceiveBufferIndex], 1) == 0;
+    }
+    if (!buffersRegistered) {
+        Logger::log("Warning: io_uring buffer registration failed, using unregistered receives: " + std::string(strerror(errno)));
+    }
+    receiveBufferBusy = false;
+    callerBuffer = {};
+}
+
+/**
+ * @brief Unmaps the rings and closes the io_uring descriptor.
+ */
+void LinuxUringNetworkInterface::teardownRing() {
+    if (sqes) {
+        munmap(sqes, sqesSize);
+        sqes = nullptr;
+    }
+    if (cqRingPtr && cqRingPtr != sqRingPtr) {
+        munmap(cqRingPtr, cqRingSize);
+    }
+    cqRingPtr = nullptr;
+    if (sqRingPtr) {
+        munmap(sqRingPtr, sqRingSize);
+        sqRingPtr = nullptr;
+    }
+    if (ringFd != -1) {
+        ::close(ringFd); // Also unregisters the fixed buffers.
+        ringFd = -1;
+    }
+    buffersRegistered = false;
+    callerSlotRegistered = false;
+    callerBuffer = {};
+}
+
+/**
+ * @brief Creates the ring, the optional listening socket, and the completion thread.
+ * @param ip The IP address to use.
+ * @param port The port to use. A non-zero port selects server mode.
+ * @return True on success, false on failure.
+ */
+bool LinuxUringNetworkInterface::initialize(const std::string& ip, int port) {
+    if (!setupRing()) {
+        return false;
+    }
+
+    if (port != 0) { // Server mode: set up listening socket
+        listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        if (listenFd == -1) {
+            Logger::log("Error: socket creation failed: " + std::string(strerror(errno)));
+            teardownRing();
+            return false;
+        }
+
+        int opt = 1;
+        if (setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) == -1) {
+            Logger::log("Warning: setsockopt(SO_REUSEADDR) failed");
+        }
+
+        sockaddr_in serverAddr;
+        memset(&serverAddr, 0, sizeof(serverAddr));
+        serverAddr.sin_family = AF_INET;
+        if (inet_pton(AF_INET, ip.c_str(), &serverAddr.sin_addr) <= 0) {
+            if (ip.empty()) {
+                serverAddr.sin_addr.s_addr = INADDR_ANY;
+            } else {
+                Logger::log("Error: Invalid IP address: " + ip);
+                ::close(listenFd);
+                listenFd = -1;
+                teardownRing();
+                return false;
+            }
+        }
+        serverAddr.sin_port = htons(port);
+
+        if (bind(listenFd, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) == -1) {
+            Logger::log("Error: bind failed: " + std::string(strerror(errno)));
+            ::close(listenFd);
+            listenFd = -1;
+            teardownRing();
+            return false;
+        }
+
+        if (listen(listenFd, SOMAXCONN) == -1) {
+            Logger::log("Error: listen failed: " + std::string(strerror(errno)));
+            ::close(listenFd);
+            listenFd = -1;
+            teardownRing();
+            return false;
+        }
+
+        Logger::log("Info: Server listening on " + ip + ":" + std::to_string(port));
+    }
+
+    running = true;
+    workerThread = std::thread(&LinuxUringNetworkInterface::completionThread, this);
+    Logger::log("Info: io_uring network interface initialized.");
+
+    return true;
+}
+
+bool LinuxUringNetworkInterface::prepareServer(const std::string& ip, int port) {
+    return initialize(ip, port);
+}
+
+/**
+ * @brief Shuts down the interface.
+ *
+ * In-flight operations are cancelled and drained by the completion thread
+ * without invoking their callbacks, so the kernel no longer references any
+ * operation context or buffer when the ring is torn down.
+ */
+void LinuxUringNetworkInterface::close() {
+    if (!running.exchange(false)) {
+        return; // Already closed
+    }
+
+    if (clientFd != -1) {
+        shutdown(clientFd, SHUT_RDWR);
+    }
+    if (listenFd != -1) {
+        shutdown(listenFd, SHUT_RDWR);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        for (UringOperation* op : inFlight) {
+            unsigned tail = *sqTail;
+            if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+                // Hand the queued cancels to the kernel to make room. An operation
+                // left uncancelled would hold up the join below until it completes
+                // on its own, e.g. a timer at its deadline.
+                controlCalls.fetch_add(1, std::memory_order_relaxed);
+                uringEnter(ringFd, tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE), 0, 0);
+                if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+                    Logger::log("Warning: io_uring submission queue is full; some operations are not cancelled.");
+                    break;
+                }
+            }
+            io_uring_sqe* sqe = &sqes[tail & *sqRingMask];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = reinterpret_cast<uint64_t>(op);
+            sqe->user_data = 0; // Cancel completions are not tracked.
+            sqArray[tail & *sqRingMask] = tail & *sqRingMask;
+            __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        }
+    }
+
+    auto* wakeup = new UringOperation();
+    wakeup->operationType = UringOperationType::Wakeup;
+    if (!submit(wakeup)) {
+        delete wakeup;
+    }
+
+    if (workerThread.joinable()) {
+        workerThread.join();
+    }
+
+    if (listenFd != -1) {
+        ::close(listenFd);
+        listenFd = -1;
+    }
+    if (clientFd != -1) {
+        ::close(clientFd);
+        clientFd = -1;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        for (UringOperation* op : inFlight) {
+            delete op;
+        }
+        inFlight.clear();
+        teardownRing();
+    }
+
+    Logger::log("Info: Network interface closed.");
+}
+
+/**
+ * @brief Asynchronously connects to a server with IORING_OP_CONNECT.
+ * @param ip The server's IP address.
+ * @param port The server's port.
+ * @param callback The function to call upon completion.
+ */
+void LinuxUringNetworkInterface::doAsyncConnect(const std::string& ip, int port, ConnectCallback callback) {
+    clientFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (clientFd == -1) {
+        Logger::log("Error: Socket creation for connect failed: " + std::string(strerror(errno)));
+        callback(false);
+        return;
+    }
+
+    auto* op = new UringOperation();
+    op->operationType = UringOperationType::Connect;
+    op->fd = clientFd;
+    op->connectCallback = std::move(callback);
+    op->address.sin_family = AF_INET;
+    inet_pton(AF_INET, ip.c_str(), &op->address.sin_addr);
+    op->address.sin_port = htons(port);
+
+    if (!submit(op)) {
+        Logger::log("Error: io_uring connect submission failed.");
+        ConnectCallback cb = std::move(op->connectCallback);
+        delete op;
+        ::close(clientFd);
+        clientFd = -1;
+        cb(false);
+    }
+}
+
+/**
+ * @brief Asynchronously accepts a client connection with IORING_OP_ACCEPT.
+ * @param callback The function to call upon completion.
+ */
+void LinuxUringNetworkInterface::doAsyncAccept(AcceptCallback callback) {
+    if (listenFd == -1) {
+        Logger::log("Error: asyncAccept called but no listen socket is configured.");
+        callback(false, "", 0);
+        return;
+    }
+
+    auto* op = new UringOperation();
+    op->operationType = UringOperationType::Accept;
+    op->fd = listenFd;
+    op->acceptCallback = std::move(callback);
+
+    if (!submit(op)) {
+        Logger::log("Error: io_uring accept submission failed.");
+        AcceptCallback cb = std::move(op->acceptCallback);
+        delete op;
+        cb(false, "", 0);
+    }
+}
+
+/**
+ * @brief Asynchronously sends data with IORING_OP_SEND.
+ *
+ * Payloads that fit a staging slot are copied into pre-allocated memory;
+ * larger ones keep a heap copy for the lifetime of the operation.
+ * Short writes are resubmitted until the whole buffer has been accepted.
+ * @param data The data to send.
+ * @param callback The function to call upon completion.
+ */
+void LinuxUringNetworkInterface::doAsyncSend(std::vector<char> data, SendCallback callback) {
+    if (clientFd == -1) {
+        Logger::log("Error: asyncSend called on an invalid socket.");
+        callback(0);
+        return;
+    }
+
+    auto* op = new UringOperation();
+    op->operationType = UringOperationType::Send;
+    op->fd = clientFd;
+    op->sendSize = data.size();
+    op->sendCallback = std::move(callback);
+
+    if (data.size() <= kSendSlotSize) {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        if (!freeSendSlots.empty()) {
+            op->bufferIndex = freeSendSlots.back();
+            freeSendSlots.pop_back();
+        }
+    }
+    if (op->bufferIndex >= 0) {
+        char* slot = sendSlots.data() + static_cast<size_t>(op->bufferIndex) * kSendSlotSize;
+        memcpy(slot, data.data(), data.size());
+        op->sendBuffer = slot;
+    } else {
+        op->data = std::move(data);
+        op->sendBuffer = op->data.data();
+    }
+
+    if (!submit(op)) {
+        Logger::log("Error: io_uring send submission failed.");
+        SendCallback cb = std::move(op->sendCallback);
+        releaseSendSlot(op->bufferIndex);
+        delete op;
+        cb(0);
+    }
+}
+
+/**
+ * @brief Asynchronously sends bytes borrowed from the caller.
+ * The awaiting coroutine keeps the span alive until the callback, so the SQE
+ * points at it directly and neither a slot nor a heap copy is needed.
+ * @param data The bytes to send.
+ * @param callback The function to call upon completion.
+ */
+void LinuxUringNetworkInterface::doAsyncSendSpan(std::span<const char> data, SendCallback callback) {
+    if (clientFd == -1) {
+        Logger::log("Error: asyncSend called on an invalid socket.");
+        callback(0);
+        return;
+    }
+
+    auto* op = new UringOperation();
+    op->operationType = UringOperationType::Send;
+    op->fd = clientFd;
+    op->sendBuffer = data.data();
+    op->sendSize = data.size();
+    op->sendCallback = std::move(callback);
+
+    if (!submit(op)) {
+        Logger::log("Error: io_uring send submission failed.");
+        SendCallback cb = std::move(op->sendCallback);
+        delete op;
+        cb(0);
+    }
+}
+
+/**
+ * @brief Asynchronously receives data into the caller's buffer.
+ *
+ * A span inside the memory given to registerReceiveMemory() is read with
+ * READ_FIXED and counted as a buffer hit; any other span is received with
+ * IORING_OP_RECV and counted as direct.
+ * @param buffer The memory to receive into, valid until the callback.
+ * @param callback The function to call upon completion.
+ */
+void LinuxUringNetworkInterface::doAsyncReceiveInto(std::span<char> buffer, RecvIntoCallback callback) {
+    if (clientFd == -1) {
+        Logger::log("Error: asyncReceive called on an invalid socket.");
+        callback(0);
+        return;
+    }
+
+    auto* op = new UringOperation();
+    op->operationType = UringOperationType::Recv;
+    op->fd = clientFd;
+    op->recvTarget = buffer.data();
+    op->sendSize = buffer.size();
+    op->recvIntoCallback = std::move(callback);
+
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        const auto begin = reinterpret_cast<uintptr_t>(buffer.data());
+        const auto registered = reinterpret_cast<uintptr_t>(callerBuffer.data());
+        if (!callerBuffer.empty() && begin >= registered &&
+            begin + buffer.size() <= registered + callerBuffer.size()) {
+            op->bufferIndex = kCallerBufferIndex;
+        }
+    }
+    if (op->bufferIndex >= 0) {
+        recvBufferHits.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        recvDirect.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (!submit(op)) {
+        Logger::log("Error: io_uring receive submission failed.");
+        RecvIntoCallback cb = std::move(op->recvIntoCallback);
+        delete op;
+        cb(0);
+    }
+}
+
+/**
+ * @brief Puts the caller's receive memory in fixed buffer slot 1.
+ *
+ * The update replaces whatever the slot held; a READ_FIXED still in flight
+ * keeps the old memory pinned until it completes. If the update fails the
+ * slot is left unused and receiveInto() falls back to IORING_OP_RECV.
+ * @param memory The memory later receiveInto() spans lie in, or an empty span.
+ */
+void LinuxUringNetworkInterface::registerReceiveMemory(std::span<char> memory) {
+    std::lock_guard<std::mutex> lock(submitMutex);
+    bool updated = false;
+    if (ringFd != -1 && callerSlotRegistered) {
+        iovec vec;
+        vec.iov_base = memory.data();
+        vec.iov_len = memory.size();
+        io_uring_rsrc_update2 update;
+        memset(&update, 0, sizeof(update));
+        update.offset = kCallerBufferIndex;
+        update.data = reinterpret_cast<uint64_t>(&vec);
+        update.nr = 1;
+        controlCalls.fetch_add(1, std::memory_order_relaxed);
+        updated = uringRegister(ringFd, IORING_REGISTER_BUFFERS_UPDATE, &update, sizeof(update)) == 1;
+        if (!updated && !memory.empty()) {
+            Logger::log("Warning: io_uring receive memory registration failed, using unregistered receives: " +
+                        std::string(strerror(errno)));
+        }
+    }
+    std::lock_guard<std::mutex> bufferLock(bufferMutex);
+    callerBuffer = updated ? memory : std::span<char>();
+}
+
+void LinuxUringNetworkInterface::doAsyncWait(std::chrono::steady_clock::time_point deadline, TimerCallback callback) {
+    // steady_clock is CLOCK_MONOTONIC, the clock IORING_TIMEOUT_ABS measures against.
+    const auto sinceEpoch = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    auto* op = new UringOperation();
+    op->operationType = UringOperationType::Timer;
+    op->timeout.tv_sec = sinceEpoch / 1'000'000'000;
+    op->timeout.tv_nsec = sinceEpoch % 1'000'000'000;
+    op->timerCallback = std::move(callback);
+
+    if (!submit(op)) {
+        Logger::log("Warning: io_uring timer submission failed. Using the shared timer thread.");
+        TimerCallback cb = std::move(op->timerCallback);
+        delete op;
+        NetworkInterface::doAsyncWait(deadline, std::move(cb));
+    }
+}
+
+/**
+ * @brief Asynchronously receives data into the registered buffer.
+ * @param bufferSize The maximum number of bytes to receive.
+ * @param callback The function to call upon completion.
+ */
+void LinuxUringNetworkInterface::doAsyncReceive(size_t bufferSize, RecvCallback callback) {
+    if (clientFd == -1) {
+        Logger::log("Error: asyncReceive called on an invalid socket.");
+        callback({}, 0);
+        return;
+    }
+
+    auto* op = new UringOperation();
+    op->operationType = UringOperationType::Recv;
+    op->fd = clientFd;
+    op->recvCallback = std::move(callback);
+
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex);
+        if (buffersRegistered && !receiveBufferBusy) {
+            receiveBufferBusy = true;
+            op->bufferIndex = kReceiveBufferIndex;
+        }
+    }
+    if (op->bufferIndex < 0) {
+        recvBufferMisses.fetch_add(1, std::memory_order_relaxed);
+        op->data.resize(bufferSize);
+    } else {
+        recvBufferHits.fetch_add(1, std::memory_order_relaxed);
+    }
+    op->sendSize = op->bufferIndex >= 0 ? std::min(bufferSize, receiveBuffer.size()) : bufferSize;
+
+    if (!submit(op)) {
+        Logger::log("Error: io_uring receive submission failed.");
+        RecvCallback cb = std::move(op->recvCallback);
+        if (op->bufferIndex >= 0) {
+            std::lock_guard<std::mutex> lock(bufferMutex);
+            receiveBufferBusy = false;
+        }
+        delete op;
+        cb({}, 0);
+    }
+}
+
+/**
+ * @brief Queues one SQE for the operation.
+ *
+ * Calls made on the completion thread only publish the SQE; the thread's next
+ * io_uring_enter submits everything queued during the current completion batch.
+ * Calls from any other thread submit immediately because the completion thread
+ * may be blocked waiting for events.
+ */
+bool LinuxUringNetworkInterface::submit(UringOperation* op) {
+    std::lock_guard<std::mutex> lock(submitMutex);
+    if (ringFd == -1 || !sqes) {
+        return false;
+    }
+
+    unsigned tail = *sqTail;
+    if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+        controlCalls.fetch_add(1, std::memory_order_relaxed);
+        uringEnter(ringFd, tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE), 0, 0);
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) {
+            Logger::log("Error: io_uring submission queue is full.");
+            return false;
+        }
+    }
+
+    const unsigned index = tail & *sqRingMask;
+    io_uring_sqe* sqe = &sqes[index];
+    prepareSqe(sqe, op);
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    inFlight.insert(op);
+    if (op->operationType == UringOperationType::Send) {
+        sendOps.fetch_add(1, std::memory_order_relaxed);
+    } else if (op->operationType == UringOperationType::Recv || op->operationType == UringOperationType::Accept) {
+        recvOps.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (std::this_thread::get_id() != workerThread.get_id()) {
+        controlCalls.fetch_add(1, std::memory_order_relaxed);
+        const unsigned toSubmit = (tail + 1) - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (uringEnter(ringFd, toSubmit, 0, 0) < 0 && errno != EAGAIN && errno != EBUSY && errno != EINTR) {
+            Logger::log("Error: io_uring_enter (submit) failed: " + std::string(strerror(errno)));
+        }
+    }
+    return true;
+}
+
+NetworkIoStats LinuxUringNetworkInterface::getIoStats() const {
+    NetworkIoStats stats;
+    stats.backend = "io_uring";
+    stats.sendCalls = sendOps.load(std::memory_order_relaxed);
+    stats.recvCalls = recvOps.load(std::memory_order_relaxed);
+    stats.waitCalls = waitCalls.load(std::memory_order_relaxed);
+    stats.controlCalls = controlCalls.load(std::memory_order_relaxed);
+    stats.recvBufferHits = recvBufferHits.load(std::memory_order_relaxed);
+    stats.recvBufferMisses = recvBufferMisses.load(std::memory_order_relaxed);
+    stats.recvDirect = recvDirect.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool LinuxUringNetworkInterface::setPacingRate(uint64_t bytesPerSecond) {
+    if (clientFd == -1) {
+        return bytesPerSecond == 0;
+    }
+    // See LinuxAsyncNetworkInterface::setPacingRate for the 64-bit option value.
+    const uint64_t rate = bytesPerSecond > 0 ? bytesPerSecond : ~0ULL;
+    controlCalls.fetch_add(1, std::memory_order_relaxed);
+    if (setsockopt(clientFd, SOL_SOCKET, SO_MAX_PACING_RATE, &rate, sizeof(rate)) == -1) {
+        Logger::log("Warning: setsockopt(SO_MAX_PACING_RATE) failed: " + std::string(strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
+void LinuxUringNetworkInterface::prepareSqe(io_uring_sqe* sqe, UringOperation* op) {
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->fd = op->fd;
+    sqe->user_data = reinterpret_cast<uint64_t>(op);
+
+    switch (op->operationType) {
+        case UringOperationType::Recv:
+            if (op->bufferIndex >= 0) {
+                sqe->opcode = IORING_OP_READ_FIXED;
+                sqe->addr = reinterpret_cast<uint64_t>(op->recvTarget ? op->recvTarget : receiveBuffer.data());
+                sqe->len = static_cast<uint32_t>(op->sendSize);
+                sqe->buf_index = static_cast<uint16_t>(op->bufferIndex);
+                sqe->off = 0;
+            } else {
+                sqe->opcode = IORING_OP_RECV;
+                sqe->addr = reinterpret_cast<uint64_t>(op->recvTarget ? op->recvTarget : op->data.data());
+                sqe->len = static_cast<uint32_t>(op->sendSize);
+            }
+            break;
+        case UringOperationType::Send:
+            sqe->opcode = IORING_OP_SEND;
+            sqe->addr = reinterpret_cast<uint64_t>(op->sendBuffer + op->sendOffset);
+            sqe->len = static_cast<uint32_t>(op->sendSize - op->sendOffset);
+            sqe->msg_flags = MSG_NOSIGNAL;
+            break;
+        case UringOperationType::Accept:
+            sqe->opcode = IORING_OP_ACCEPT;
+            op->addressLength = sizeof(op->address);
+            sqe->addr = reinterpret_cast<uint64_t>(&op->address);
+            sqe->addr2 = reinterpret_cast<uint64_t>(&op->addressLength);
+            break;
+        case UringOperationType::Connect:
+            sqe->opcode = IORING_OP_CONNECT;
+            sqe->addr = reinterpret_cast<uint64_t>(&op->address);
+            sqe->off = sizeof(op->address);
+            break;
+        case UringOperationType::Wakeup:
+            sqe->opcode = IORING_OP_NOP;
+            sqe->fd = -1;
+            break;
+        case UringOperationType::Timer:
+            sqe->opcode = IORING_OP_TIMEOUT;
+            sqe->fd = -1;
+            sqe->addr = reinterpret_cast<uint64_t>(&op->timeout);
+            sqe->len = 1;
+            sqe->off = 0; // Complete on the deadline only, not after a number of other completions.
+            sqe->timeout_flags = IORING_TIMEOUT_ABS;
+            break;
+    }
+}
+
+/**
+ * @brief The completion thread.
+ *
+ * Each iteration performs a single io_uring_enter that submits every SQE queued
+ * since the previous iteration and waits for at least one completion, then
+ * reaps the whole CQ batch.
+ */
+void LinuxUringNetworkInterface::completionThread() {
+    Logger::log("Info: io_uring completion thread starting.");
+
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(submitMutex);
+            if (!running.load() && inFlight.empty()) {
+                break;
+            }
+        }
+
+        const unsigned toSubmit = __atomic_load_n(sqTail, __ATOMIC_ACQUIRE) - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        waitCalls.fetch_add(1, std::memory_order_relaxed);
+        int ret = uringEnter(ringFd, toSubmit, 1, IORING_ENTER_GETEVENTS);
+        if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            Logger::log("Error: io_uring_enter failed: " + std::string(strerror(errno)));
+            break;
+        }
+
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes[head & *cqRingMask];
+            auto* op = reinterpret_cast<UringOperation*>(cqe.user_data);
+            const int res = cqe.res;
+            ++head;
+            // Release the CQ slot before running callbacks, which may submit more work.
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+            if (op) {
+                handleCompletion(op, res);
+            }
+
+            if (head == tail) {
+                tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+            }
+        }
+    }
+
+    Logger::log("Info: io_uring completion thread stopping.");
+}
+
+void LinuxUringNetworkInterface::handleCompletion(UringOperation* op, int res) {
+    if (!running.load() || op->operationType == UringOperationType::Wakeup) {
+        // Shutting down: drain without resuming any coroutine.
+        if (op->operationType == UringOperationType::Send) {
+            releaseSendSlot(op->bufferIndex);
+        }
+        retire(op);
+        return;
+    }
+
+    switch (op->operationType) {
+        case UringOperationType::Recv: {
+            if (op->recvTarget) {
+                // The bytes are already in the caller's buffer.
+                RecvIntoCallback cb = std::move(op->recvIntoCallback);
+                if (res == 0) {
+                    Logger::log("Info: Connection closed by peer.");
+                } else if (res < 0 && res != -ECANCELED) {
+                    Logger::log("Error: recv failed: " + std::string(strerror(-res)));
+                }
+                retire(op);
+                if (cb) cb(res > 0 ? static_cast<size_t>(res) : 0);
+                break;
+            }
+            RecvCallback cb = std::move(op->recvCallback);
+            if (res > 0) {
+                // Lend the buffer to the callback instead of copying it. The registered
+                // buffer can be released first: a receive queued from the callback is
+                // only submitted after this completion batch has been handled.
+                if (op->bufferIndex >= 0) {
+                    {
+                        std::lock_guard<std::mutex> lock(bufferMutex);
+                        receiveBufferBusy = false;
+                    }
+                    retire(op);
+                    if (cb) cb(receiveBuffer, static_cast<size_t>(res));
+                } else {
+                    std::vector<char> receivedData = std::move(op->data);
+                    retire(op);
+                    if (cb) cb(receivedData, static_cast<size_t>(res));
+                }
+            } else {
+                if (res == 0) {
+                    Logger::log("Info: Connection closed by peer.");
+                } else if (res != -ECANCELED) {
+                    Logger::log("Error: recv failed: " + std::string(strerror(-res)));
+                }
+                if (op->bufferIndex >= 0) {
+                    std::lock_guard<std::mutex> lock(bufferMutex);
+                    receiveBufferBusy = false;
+                }
+                retire(op);
+                if (cb) cb({}, 0);
+            }
+            break;
+        }
+        case UringOperationType::Send: {
+            if (res > 0) {
+                op->sendOffset += static_cast<size_t>(res);
+                if (op->sendOffset < op->sendSize) {
+                    // Short write: queue the remainder with the same context.
+                    if (submit(op)) {
+                        return;
+                    }
+                    res = -EIO;
+                }
+            }
+            SendCallback cb = std::move(op->sendCallback);
+            const size_t sent = res > 0 ? op->sendOffset : 0;
+            if (res <= 0) {
+                Logger::log("Error: send failed: " + std::string(strerror(res == 0 ? EPIPE : -res)));
+            }
+            releaseSendSlot(op->bufferIndex);
+            retire(op);
+            if (cb) cb(sent);
+            break;
+        }
+        case UringOperationType::Accept: {
+            AcceptCallback cb = std::move(op->acceptCallback);
+            if (res >= 0) {
+                clientFd = res;
+                char ipStr[INET_ADDRSTRLEN];
+                inet_ntop(AF_INET, &op->address.sin_addr, ipStr, INET_ADDRSTRLEN);
+                const int port = ntohs(op->address.sin_port);
+                retire(op);
+                if (cb) cb(true, std::string(ipStr), port);
+            } else {
+                Logger::log("Error: accept failed: " + std::string(strerror(-res)));
+                retire(op);
+                if (cb) cb(false, "", 0);
+            }
+            break;
+        }
+        case UringOperationType::Connect: {
+            ConnectCallback cb = std::move(op->connectCallback);
+            retire(op);
+            if (res != 0) {
+                Logger::log("Error: Async connect failed: " + std::string(strerror(-res)));
+                if (cb) cb(false);
+            } else {
+                if (cb) cb(true);
+            }
+            break;
+        }
+        case UringOperationType::Timer: {
+            // -ETIME is the normal expiry. Resume on any other result as well, so a
+            // kernel that rejects the timeout cannot leave the coroutine suspended.
+            if (res != -ETIME && res != 0) {
+                Logger::log("Warning: io_uring timeout completed with: " + std::string(strerror(-res)));
+            }
+            TimerCallback cb = std::move(op->timerCallback);
+            retire(op);
+            if (cb) cb();
+            break;
+        }
+        case UringOperationType::Wakeup:
+            break;
+    }
+}
+
+void LinuxUringNetworkInterface::releaseSendSlot(int index) {
+    if (index < 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(bufferMutex);
+    freeSendSlots.push_back(index);
+}
+
+void LinuxUringNetworkInterface::retire(UringOperation* op) {
+    {
+        std::lock_guard<std::mutex> lock(submitMutex);
+        inFlight.erase(op);
+    }
+    delete op;
+}
+
+#endif // __linux__ && MYIPERF_HAS_IO_URING
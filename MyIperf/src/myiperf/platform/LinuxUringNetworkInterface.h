@@ -0,0 +1,295 @@
+// LinuxUringNetworkInterface.h
+#pragma once
+
+#if defined(__linux__) && defined(MYIPERF_HAS_IO_URING) // Guard for Linux io_uring builds
+#include "myiperf/NetworkInterface.h"
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @enum UringOperationType
+ * @brief Defines the type of asynchronous operation submitted to io_uring.
+ */
+enum class UringOperationType {
+    Recv,    /**< A receive operation. */
+    Send,    /**< A send operation. */
+    Accept,  /**< An accept operation (server-side). */
+    Connect, /**< A connect operation (client-side). */
+    Wakeup,  /**< A NOP used to wake the completion thread on shutdown. */
+    Timer    /**< An IORING_OP_TIMEOUT with an absolute CLOCK_MONOTONIC deadline. */
+};
+
+/**
+ * @struct UringOperation
+ * @brief Per-submission context, carried through io_uring as the SQE user_data.
+ *
+ * Like IO_DATA in the IOCP backend, one object is allocated per in-flight
+ * operation and released by the completion thread once its callback has run.
+ */
+struct UringOperation {
+    /**< The kind of operation this context represents. */
+    UringOperationType operationType;
+    /**< The socket the operation targets. */
+    int fd = -1;
+    /**< Heap buffer for sends that did not get a slot, or unregistered receives. */
+    std::vector<char> data;
+    /**< Start of the bytes to send (slot memory, data.data() or the caller's span). */
+    const char* sendBuffer = nullptr;
+    /**< Caller memory a receiveInto writes to; null for slot or heap receives. */
+    char* recvTarget = nullptr;
+    /**< Total number of bytes to send, or the receive length. */
+    size_t sendSize = 0;
+    /**< Bytes already accepted by the kernel for this send. */
+    size_t sendOffset = 0;
+    /**< Send slot index or fixed receive buffer index; -1 when heap memory is used. */
+    int bufferIndex = -1;
+    /**< Peer address for connect, or the accepted peer address. */
+    sockaddr_in address{};
+    /**< Length of address, updated by the kernel for accept. */
+    socklen_t addressLength = sizeof(sockaddr_in);
+
+    // Callbacks for asynchronous operations
+    RecvCallback recvCallback;
+    RecvIntoCallback recvIntoCallback;
+    SendCallback sendCallback;
+    ConnectCallback connectCallback;
+    AcceptCallback acceptCallback;
+    TimerCallback timerCallback;
+    /**< Absolute deadline of a Timer operation; read by the kernel until completion. */
+    __kernel_timespec timeout{};
+};
+
+/**
+ * @class LinuxUringNetworkInterface
+ * @brief A Linux io_uring implementation of the NetworkInterface.
+ *
+ * Operations are queued as submission queue entries and completed in batches
+ * by a single completion thread. Requests issued from the completion thread
+ * itself (the common case, because coroutines resume there) are not submitted
+ * immediately; they are flushed together with the next wait, so one
+ * io_uring_enter call both submits the next send/recv and reaps completions.
+ * Receives land in a registered (fixed) buffer, either the interface's own or
+ * the caller memory named by registerReceiveMemory(), and small sends are
+ * staged in pre-allocated slots, so the steady state performs no per-packet
+ * allocation.
+ *
+ * The ring is driven through the raw io_uring syscalls; liburing is not required.
+ */
+class LinuxUringNetworkInterface : public NetworkInterface {
+public:
+    /**
+     * @brief Constructs a LinuxUringNetworkInterface object.
+     */
+    LinuxUringNetworkInterface();
+
+    /**
+     * @brief Destroys the object, ensuring all resources are released.
+     */
+    ~LinuxUringNetworkInterface();
+
+    /**
+     * @brief Checks whether the running kernel allows io_uring to be set up.
+     * @return True if an io_uring instance could be created.
+     */
+    static bool isSupported();
+
+    // --- Overridden NetworkInterface methods ---
+    /**
+     * @brief Creates the ring and starts the completion thread.
+     * @param ip The IP address to bind to (for servers).
+     * @param port The port to listen on, or 0 for client mode.
+     * @return True if initialization is successful, false otherwise.
+     * @override
+     */
+    bool initialize(const std::string& ip, int port) override;
+
+    /**
+     * @brief Creates the ring and the listening socket for server mode.
+     * @param ip The IP address to bind to.
+     * @param port The port to listen on.
+     * @return True if server setup is successful, false otherwise.
+     * @override
+     */
+    bool prepareServer(const std::string& ip, int port) override;
+
+    /**
+     * @brief Stops the completion thread, closes sockets and tears down the ring.
+     * @override
+     */
+    void close() override;
+
+    void doAsyncConnect(const std::string& ip, int port, ConnectCallback callback) override;
+    void doAsyncAccept(AcceptCallback callback) override;
+    void doAsyncSend(std::vector<char> data, SendCallback callback) override;
+    void doAsyncReceive(size_t bufferSize, RecvCallback callback) override;
+
+    /**
+     * @brief Sends straight from the caller's span, which stays valid until the completion.
+     * @override
+     */
+    void doAsyncSendSpan(std::span<const char> data, SendCallback callback) override;
+
+    /**
+     * @brief Receives straight into the caller's span: READ_FIXED when it lies in
+     *        memory given to registerReceiveMemory(), IORING_OP_RECV otherwise.
+     * @override
+     */
+    void doAsyncReceiveInto(std::span<char> buffer, RecvIntoCallback callback) override;
+
+    /**
+     * @brief Installs the memory as the ring's second fixed buffer.
+     * @override
+     */
+    void registerReceiveMemory(std::span<char> memory) override;
+
+    /**
+     * @brief Queues an IORING_OP_TIMEOUT, so the timer completes on the completion thread.
+     * @override
+     */
+    void doAsyncWait(std::chrono::steady_clock::time_point deadline, TimerCallback callback) override;
+
+    /**
+     * @brief Returns the ring operation and io_uring_enter counters of this interface.
+     * @override
+     */
+    NetworkIoStats getIoStats() const override;
+
+    /**
+     * @brief Sets SO_MAX_PACING_RATE on the connected socket.
+     * @override
+     */
+    bool setPacingRate(uint64_t bytesPerSecond) override;
+
+private:
+    // --- Ring management ---
+    /**
+     * @brief Creates the io_uring instance and maps its queues.
+     * @return True on success.
+     */
+    bool setupRing();
+
+    /**
+     * @brief Allocates the send slots and registers the receive buffer as a fixed buffer,
+     *        with a second, empty slot for registerReceiveMemory().
+     */
+    void registerBuffers();
+
+    /**
+     * @brief Unmaps the queues and closes the ring descriptor.
+     */
+    void teardownRing();
+
+    /**
+     * @brief Fills an SQE for the operation and queues it for submission.
+     * @param op The operation context. Ownership passes to the ring.
+     * @return True if the SQE was queued, false if the ring is unavailable.
+     */
+    bool submit(UringOperation* op);
+
+    /**
+     * @brief Writes the SQE fields for an operation. Caller holds submitMutex.
+     */
+    void prepareSqe(io_uring_sqe* sqe, UringOperation* op);
+
+    /**
+     * @brief The completion thread: flushes queued SQEs and reaps CQEs in batches.
+     */
+    void completionThread();
+
+    /**
+     * @brief Dispatches one completion to the owning operation.
+     * @param op The operation context from user_data.
+     * @param res The CQE result (bytes, fd, or -errno).
+     */
+    void handleCompletion(UringOperation* op, int res);
+
+    /**
+     * @brief Returns a send slot to the free list.
+     */
+    void releaseSendSlot(int index);
+
+    /**
+     * @brief Forgets an operation once it has completed and deletes it.
+     */
+    void retire(UringOperation* op);
+
+    /**< Listening socket for server mode. */
+    int listenFd;
+    /**< Socket of the established connection. */
+    int clientFd;
+    /**< The io_uring instance descriptor. */
+    int ringFd;
+
+    // Mapped submission queue
+    void* sqRingPtr = nullptr;
+    size_t sqRingSize = 0;
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqRingMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned sqEntries = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    // Mapped completion queue
+    void* cqRingPtr = nullptr;
+    size_t cqRingSize = 0;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqRingMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+    /**< Serializes SQ tail updates, the submit syscall and inFlight. */
+    std::mutex submitMutex;
+
+    /**< Pre-allocated send staging memory, split into fixed-size slots. */
+    std::vector<char> sendSlots;
+    /**< Receive buffer registered with the ring for READ_FIXED. */
+    std::vector<char> receiveBuffer;
+    /**< True once receiveBuffer has been registered with the ring. */
+    bool buffersRegistered = false;
+    /**< True if the ring has the fixed buffer slot registerReceiveMemory() fills (kernel 5.13+). */
+    bool callerSlotRegistered = false;
+    /**< Caller memory currently in that slot; empty if none. */
+    std::span<char> callerBuffer;
+    /**< Guards freeSendSlots, receiveBufferBusy and callerBuffer. */
+    std::mutex bufferMutex;
+    /**< Free send slot indices. */
+    std::vector<int> freeSendSlots;
+    /**< True while the fixed receive buffer is owned by an in-flight receive. */
+    bool receiveBufferBusy = false;
+
+    /**< Operations that have been submitted and not yet completed. Guarded by submitMutex. */
+    std::unordered_set<UringOperation*> inFlight;
+
+    /**< The completion thread. */
+    std::thread workerThread;
+    /**< Flag to control the running state of the completion thread. */
+    std::atomic<bool> running;
+
+    // Counters reported through getIoStats()
+    /**< Send operations queued on the ring (not syscalls). */
+    std::atomic<long long> sendOps{0};
+    /**< Receive and accept operations queued on the ring (not syscalls). */
+    std::atomic<long long> recvOps{0};
+    /**< io_uring_enter calls that wait for completions. */
+    std::atomic<long long> waitCalls{0};
+    /**< Submit-only io_uring_enter and io_uring_register calls. */
+    std::atomic<long long> controlCalls{0};
+    /**< Receives into the registered buffer or registered caller memory. */
+    std::atomic<long long> recvBufferHits{0};
+    /**< Receives that fell back to a heap buffer because the registered one was busy. */
+    std::atomic<long long> recvBufferMisses{0};
+    /**< Receives into caller memory that is not registered. */
+    std::atomic<long long> recvDirect{0};
+};
+
+#endif // __linux__ && MYIPERF_HAS_IO_URING
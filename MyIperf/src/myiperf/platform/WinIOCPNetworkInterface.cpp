@@ -6,7 +6,6 @@
 #include <chrono>
 #include <ws2tcpip.h> // For InetPton, InetNtop
 #include <string>
-#include <sstream>
 #include <Mswsock.h> // For CancelIoEx
 
 #pragma comment(lib, "Mswsock.lib")
@@ -103,7 +102,7 @@ void WinIOCPNetworkInterface::close() {
     if (!running.exchange(false)) {
         return; // Already closed or closing
     }
-    Logger::log("Debug: WinIOCPNetworkInterface::close() started.");
+    MYIPERF_LOG_DEBUG("WinIOCPNetworkInterface::close() started.");
 
     // 1. Cancel any pending I/O operations on the sockets.
     // This helps unblock the worker threads from GetQueuedCompletionStatus.
@@ -113,21 +112,21 @@ void WinIOCPNetworkInterface::close() {
     if (clientSocket != INVALID_SOCKET) {
         CancelIoEx((HANDLE)clientSocket, NULL);
     }
-    Logger::log("Debug: Canceled pending I/O operations.");
+    MYIPERF_LOG_DEBUG("Canceled pending I/O operations.");
 
     // 2. Gracefully shut down the sockets.
     // This signals the other side of the connection that we are closing.
     if (clientSocket != INVALID_SOCKET) {
         shutdown(clientSocket, SD_BOTH);
     }
-    Logger::log("Debug: Shutdown client socket.");
+    MYIPERF_LOG_DEBUG("Shutdown client socket.");
 
     // 3. Post completion statuses to wake up worker threads.
     // This ensures they exit their loop if they are waiting on an empty queue.
     for (size_t i = 0; i < workerThreads.size(); ++i) {
         PostQueuedCompletionStatus(iocpHandle, 0, 0, NULL);
     }
-    Logger::log("Debug: Posted shutdown messages to worker threads.");
+    MYIPERF_LOG_DEBUG("Posted shutdown messages to worker threads.");
 
     // 4. Wait for all worker threads to terminate.
     for (auto& t : workerThreads) {
@@ -136,23 +135,23 @@ void WinIOCPNetworkInterface::close() {
         }
     }
     workerThreads.clear();
-    Logger::log("Debug: All worker threads have joined.");
+    MYIPERF_LOG_DEBUG("All worker threads have joined.");
 
     // 5. Now it's safe to close the sockets and the IOCP handle.
     if (listenSocket != INVALID_SOCKET) {
         closesocket(listenSocket);
         listenSocket = INVALID_SOCKET;
-        Logger::log("Debug: Closed listen socket.");
+        MYIPERF_LOG_DEBUG("Closed listen socket.");
     }
     if (clientSocket != INVALID_SOCKET) {
         closesocket(clientSocket);
         clientSocket = INVALID_SOCKET;
-        Logger::log("Debug: Closed client socket.");
+        MYIPERF_LOG_DEBUG("Closed client socket.");
     }
     if (iocpHandle != NULL) {
         CloseHandle(iocpHandle);
         iocpHandle = NULL;
-        Logger::log("Debug: Closed IOCP handle.");
+        MYIPERF_LOG_DEBUG("Closed IOCP handle.");
     }
 
     Logger::log("Info: Network interface closed successfully.");
@@ -291,10 +290,8 @@ void WinIOCPNetworkInterface::doAsyncAccept(AcceptCallback callback) {
  * @param data The data to send.
  * @param callback The function to call upon completion.
  */
-void WinIOCPNetworkInterface::doAsyncSend(const std::vector<char>& data, SendCallback callback) {
-#ifdef DEBUG_LOG    
-    Logger::log("Debug: asyncSend called. Data size: " + std::to_string(data.size()));
-#endif
+void WinIOCPNetworkInterface::doAsyncSend(std::vector<char> data, SendCallback callback) {
+    MYIPERF_LOG_DEBUG("asyncSend called. Data size: {}", data.size());
     if (clientSocket == INVALID_SOCKET) {
         Logger::log("Error: asyncSend called on an invalid socket.");
         callback(0);
@@ -305,7 +302,7 @@ void WinIOCPNetworkInterface::doAsyncSend(const std::vector<char>& data, SendCal
     memset(&ioData->overlapped, 0, sizeof(ioData->overlapped));
     ioData->operationType = OperationType::Send;
     ioData->sendCallback = callback;
-    ioData->sendData = data; // Copy data to be sent.
+    ioData->sendData = std::move(data); // Take ownership of the data to be sent.
 
     ioData->wsaBuf.buf = ioData->sendData.data();
     ioData->wsaBuf.len = static_cast<ULONG>(ioData->sendData.size());
@@ -318,9 +315,7 @@ void WinIOCPNetworkInterface::doAsyncSend(const std::vector<char>& data, SendCal
             delete ioData;
             callback(0);
         } else {
-#ifdef DEBUG_LOG
-            Logger::log("Debug: WSASend pending for " + std::to_string(ioData->sendData.size()) + " bytes.");
-#endif
+            MYIPERF_LOG_DEBUG("WSASend pending for {} bytes.", ioData->sendData.size());
         }
     }
 }
@@ -331,9 +326,7 @@ void WinIOCPNetworkInterface::doAsyncSend(const std::vector<char>& data, SendCal
  * @param callback The function to call upon completion.
  */
 void WinIOCPNetworkInterface::doAsyncReceive(size_t bufferSize, RecvCallback callback) {
-#ifdef DEBUG_LOG
-    Logger::log("Debug: asyncReceive called. Buffer size: " + std::to_string(bufferSize));
-#endif
+    MYIPERF_LOG_DEBUG("asyncReceive called. Buffer size: {}", bufferSize);
     if (clientSocket == INVALID_SOCKET) {
         Logger::log("Error: asyncReceive called on an invalid socket.");
         callback({}, 0);
@@ -406,25 +399,15 @@ void WinIOCPNetworkInterface::iocpWorkerThread() {
 
         switch (ioData->operationType) {
             case OperationType::Recv: {
-#ifdef DEBUG_LOG
-                Logger::log("Debug: Receive operation completed. Bytes transferred: " + std::to_string(bytesTransferred));
-#endif
+                MYIPERF_LOG_DEBUG("Receive operation completed. Bytes transferred: {}", bytesTransferred);
                 if (bytesTransferred >= sizeof(PacketHeader)) {
                     const PacketHeader* header = reinterpret_cast<const PacketHeader*>(ioData->buffer);
                     if (header->messageType != MessageType::DATA_PACKET) {
-#ifdef DEBUG_LOG
-                        std::ostringstream handshakeLog;
-                        handshakeLog << "HANDSHAKE: IOCP received message type "
-                                     << static_cast<int>(header->messageType)
-                                     << " (" << bytesTransferred << " bytes)";
-                        Logger::log(handshakeLog.str());
-#endif
+                        MYIPERF_LOG_DEBUG("HANDSHAKE: IOCP received message type {} ({} bytes)",
+                                          static_cast<int>(header->messageType), bytesTransferred);
                     }
                 } else if (bytesTransferred > 0) {
-                    std::ostringstream handshakeLog;
-                    handshakeLog << "HANDSHAKE: IOCP received partial header ("
-                                 << bytesTransferred << " bytes)";
-                    Logger::log(handshakeLog.str());
+                    MYIPERF_LOG_INFO("HANDSHAKE: IOCP received partial header ({} bytes)", bytesTransferred);
                 }
 
                 std::vector<char> receivedData(ioData->buffer, ioData->buffer + bytesTransferred);
@@ -433,9 +416,7 @@ void WinIOCPNetworkInterface::iocpWorkerThread() {
                 break;
             }
             case OperationType::Send: {
-#ifdef DEBUG_LOG
-                Logger::log("Debug: Send operation completed. Bytes transferred: " + std::to_string(bytesTransferred));
-#endif
+                MYIPERF_LOG_DEBUG("Send operation completed. Bytes transferred: {}", bytesTransferred);
                 ioData->sendCallback(bytesTransferred);
                 delete ioData;
                 break;
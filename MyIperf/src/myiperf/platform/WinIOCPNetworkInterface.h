@@ -116,7 +116,7 @@ public:
      * @param callback The function to call upon completion of the send operation.
      * @override
      */
-    void doAsyncSend(const std::vector<char>& data, SendCallback callback) override;
+    void doAsyncSend(std::vector<char> data, SendCallback callback) override;
 
     /**
      * @brief Asynchronously receives data from the socket.